@@ -1,9 +0,0 @@
-#version 330 core
-out vec4 FragColor;
-
-in vec3 CrosshairColor;
-
-void main()
-{
-    FragColor = vec4(CrosshairColor, 1.0);
-}
\ No newline at end of file
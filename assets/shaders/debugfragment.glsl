@@ -0,0 +1,9 @@
+#version 330 core
+out vec4 FragColor;
+
+in vec3 DebugColor;
+
+void main()
+{
+    FragColor = vec4(DebugColor, 1.0);
+}
\ No newline at end of file
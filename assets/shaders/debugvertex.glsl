@@ -0,0 +1,20 @@
+#version 330 core
+layout (location = 0) in vec3 aPos;
+layout (location = 1) in vec4 aColor; // Alpha of 1 Marks Screen Pixel Positions, 0 World Positions
+
+out vec3 DebugColor;
+
+layout (std140) uniform Camera // Matches CameraUniforms in camera.h
+{
+    mat4 View;
+    mat4 Projection;
+    mat4 ViewProjection;
+};
+
+uniform mat4 ScreenProjection;
+
+void main()
+{
+    gl_Position = (aColor.a > 0.5 ? ScreenProjection : ViewProjection) * vec4(aPos, 1.0);
+    DebugColor = aColor.rgb;
+}
\ No newline at end of file
@@ -9,13 +9,20 @@ uniform sampler2D TextureAtlas;
 
 vec3 Ambient = vec3(0.5, 0.5, 0.5);
 
+const float TEXTURE_DIMENSION = 0.25;     // Matches block.h
+const float TEXTURE_REPEAT_STRIDE = 256.0; // Matches block.h
+
 void main() 
 {
 	vec3 LightDir = normalize(vec3(0.5, 1, 0.5));
 	vec3 Diffuse = max(dot(Normal, LightDir), 0.0) * vec3(1);
 
 	vec3 Result = Ambient + Diffuse;
-    vec4 TextureColor = texture(TextureAtlas, TexCoord);
+
+	// TexCoord = Tile * Stride + Repeat, Wrap the Repeat so Merged Quads Tile the Atlas Entry Per Block
+	vec2 Tile = floor(TexCoord / TEXTURE_REPEAT_STRIDE);
+	vec2 Repeat = TexCoord - Tile * TEXTURE_REPEAT_STRIDE;
+    vec4 TextureColor = texture(TextureAtlas, (Tile + fract(Repeat)) * TEXTURE_DIMENSION);
 
     FragColor = TextureColor * vec4(Result, 1.0);
 }
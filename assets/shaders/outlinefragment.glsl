@@ -1,9 +0,0 @@
-#version 330 core
-out vec4 FragColor;
-
-in vec3 OutlineColor;
-
-void main()
-{
-    FragColor = vec4(OutlineColor, 1.0);
-}
\ No newline at end of file
@@ -1,15 +0,0 @@
-#version 330 core
-layout (location = 0) in vec3 aPos;
-
-out vec3 OutlineColor;
-
-uniform vec3 Color;
-uniform mat4 Model;
-uniform mat4 View;
-uniform mat4 Projection;
-
-void main()
-{
-    gl_Position = Projection * View * Model * vec4(aPos, 1.0);
-    OutlineColor = Color;
-}
\ No newline at end of file
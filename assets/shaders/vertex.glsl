@@ -1,22 +1,64 @@
 #version 330 core
 
+#ifdef PACKED_VERTICES
+layout (location = 0) in uvec2 aPacked;
+#else
 layout (location = 0) in vec3 aPos;
 layout (location = 1) in vec3 aNormal;
 layout (location = 2) in vec2 aTexCoord;
+#endif
 
 out vec2 TexCoord;
 out vec3 FragPos;
 out vec3 Normal;
 
-uniform mat4 Model;
-uniform mat4 View;
-uniform mat4 Projection;
+layout (std140) uniform Camera // Matches CameraUniforms in camera.h
+{
+    mat4 View;
+    mat4 Projection;
+    mat4 ViewProjection;
+};
+
+#ifdef PACKED_VERTICES
+uniform isamplerBuffer ChunkOrigins; // World X/Z of Each Chunk Slot, Written by CreateChunk
+#endif
+
+#ifdef PACKED_VERTICES
+const float BLOCK_RENDER_SIZE = 0.5;       // Matches block.h
+const float TEXTURE_REPEAT_STRIDE = 256.0; // Matches block.h
+const uint ATLAS_TILES = 4u;               // Matches block.h
+
+// Indexed by BlockFace
+const vec3 FaceNormals[6] = vec3[6](
+    vec3(0.0, 0.0, 1.0),
+    vec3(0.0, 0.0, -1.0),
+    vec3(1.0, 0.0, 0.0),
+    vec3(-1.0, 0.0, 0.0),
+    vec3(0.0, 1.0, 0.0),
+    vec3(0.0, -1.0, 0.0)
+);
+#endif
 
 void main() 
 {
-    FragPos = vec3(Model * vec4(aPos, 1.0f));
+#ifdef PACKED_VERTICES
+    // Layout Matches PackedVertex in chunk.h
+    vec3 aPos = vec3(aPacked.x & 31u, (aPacked.x >> 5) & 255u, (aPacked.x >> 13) & 31u) - BLOCK_RENDER_SIZE;
+    uint Face = (aPacked.x >> 18) & 7u;
+    uint Tile = (aPacked.x >> 21) & 15u;
+    vec2 Repeat = vec2(aPacked.y & 255u, (aPacked.y >> 8) & 255u);
+
+    ivec2 Origin = texelFetch(ChunkOrigins, int(aPacked.y >> 16)).xy;
+    aPos += vec3(Origin.x, 0.0, Origin.y);
+
+    vec3 aNormal = FaceNormals[Face];
+    vec2 aTexCoord = vec2(Tile % ATLAS_TILES, Tile / ATLAS_TILES) * TEXTURE_REPEAT_STRIDE + Repeat;
+#endif
+
+    // Positions are in World Space by Now, Every Chunk Shares One Draw
+    FragPos = aPos;
     TexCoord = aTexCoord;
     Normal = aNormal;
 
-    gl_Position = Projection * View * vec4(FragPos, 1.0);
+    gl_Position = ViewProjection * vec4(FragPos, 1.0);
 }
@@ -0,0 +1,44 @@
+#include <cstdlib>
+#include <new>
+
+#include "allocations.h"
+
+std::atomic<u64> AllocationCount{0};
+std::atomic<u64> AllocationBytes{0};
+
+// Counted Allocation Both the Scalar & Array Forms Share, Paired With ReleaseCounted by Every Delete Below
+static void* AllocateCounted(size_t Size) noexcept
+{
+    AllocationCount.fetch_add(1, std::memory_order_relaxed);
+    AllocationBytes.fetch_add(Size, std::memory_order_relaxed);
+    return malloc(Size ? Size : 1);
+}
+
+static void ReleaseCounted(void* Memory) noexcept
+{
+    free(Memory);
+}
+
+void* operator new(size_t Size)
+{
+    void* Memory = AllocateCounted(Size);
+    if (!Memory) throw std::bad_alloc();
+    return Memory;
+}
+
+void* operator new[](size_t Size)
+{
+    void* Memory = AllocateCounted(Size);
+    if (!Memory) throw std::bad_alloc();
+    return Memory;
+}
+
+void* operator new(size_t Size, const std::nothrow_t&) noexcept { return AllocateCounted(Size); }
+void* operator new[](size_t Size, const std::nothrow_t&) noexcept { return AllocateCounted(Size); }
+
+void operator delete(void* Memory) noexcept { ReleaseCounted(Memory); }
+void operator delete[](void* Memory) noexcept { ReleaseCounted(Memory); }
+void operator delete(void* Memory, size_t) noexcept { ReleaseCounted(Memory); }
+void operator delete[](void* Memory, size_t) noexcept { ReleaseCounted(Memory); }
+void operator delete(void* Memory, const std::nothrow_t&) noexcept { ReleaseCounted(Memory); }
+void operator delete[](void* Memory, const std::nothrow_t&) noexcept { ReleaseCounted(Memory); }
@@ -0,0 +1,10 @@
+#pragma once
+
+#include <atomic>
+
+#include "utils/common.h"
+
+// Global Allocation Counters, Every operator new in the Process Goes Through Here
+// The Replacements Live in Their Own Translation Unit so Callers Can't Inline Them & Pair free With new
+extern std::atomic<u64> AllocationCount;
+extern std::atomic<u64> AllocationBytes;
@@ -0,0 +1,1233 @@
+// Headless Generation & Meshing Benchmark
+// Runs Fixed-Seed Scenarios Through chunk.cpp Without a Window or GL Context
+//
+// Usage: VoxelBench [scenario] [repeats]
+//   scenario: all (default), spawn, sprint, heightmap, addface, workers, cull, edit, region, directory, stream, raycast, debugdraw, profiler, lod, occlusion
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "chunk.h"
+#include "chunkmanager.h"
+#include "occlusion.h"
+#include "raycast.h"
+#include "region.h"
+#include "glm/gtc/matrix_transform.hpp"
+#include "utils/debugdraw.h"
+#include "utils/frustum.h"
+#include "utils/profiler.h"
+#include "utils/workerpool.h"
+#include "allocations.h"
+
+typedef std::chrono::steady_clock Clock;
+
+// Correctness Checks That Came Back Wrong, Any Makes main Return Non-Zero
+static u32 FailedChecks = 0;
+
+static inline f64 ElapsedNs(Clock::time_point Start, Clock::time_point End)
+{
+    return (f64)std::chrono::duration_cast<std::chrono::nanoseconds>(End - Start).count();
+}
+
+typedef struct
+{
+    f64 Mean;
+    f64 P50;
+    f64 P90;
+    f64 P99;
+    f64 Max;
+} Percentiles;
+
+static Percentiles ComputePercentiles(std::vector<f64> Samples)
+{
+    Percentiles Result = {};
+    if (Samples.empty()) return Result;
+
+    std::sort(Samples.begin(), Samples.end());
+
+    f64 Sum = 0.0;
+    for (f64 Sample : Samples) Sum += Sample;
+
+    size_t Count = Samples.size();
+    Result.Mean = Sum / Count;
+    Result.P50 = Samples[(Count - 1) * 50 / 100];
+    Result.P90 = Samples[(Count - 1) * 90 / 100];
+    Result.P99 = Samples[(Count - 1) * 99 / 100];
+    Result.Max = Samples[Count - 1];
+    return Result;
+}
+
+static void PrintPercentiles(const char* Label, const Percentiles& p, f64 Scale, const char* Unit)
+{
+    printf("  %-22s mean %9.2f  p50 %9.2f  p90 %9.2f  p99 %9.2f  max %9.2f %s\n",
+        Label, p.Mean / Scale, p.P50 / Scale, p.P90 / Scale, p.P99 / Scale, p.Max / Scale, Unit);
+}
+
+static Chunk* AllocateChunk(glm::ivec3 Position)
+{
+    Chunk* chunk = new Chunk();
+    chunk->Position = Position;
+    return chunk;
+}
+
+// Generates Every Chunk in Positions, Then Meshes Each Against its Loaded Neighbors
+// Reports Per-Chunk Timing Percentiles for Both Stages
+static void RunChunkScenario(const char* Name, const std::vector<glm::ivec3>& Positions, u32 Repeats, u8 Mode)
+{
+    std::vector<f64> GenerateSamples;
+    std::vector<f64> MeshSamples;
+    u64 TotalVertices = 0;
+    u64 TotalIndices = 0;
+    u64 GenerateAllocations = 0;
+    u64 MeshAllocations = 0;
+    u64 MeshBytes = 0;
+    u64 StorageBytes = 0;
+    u64 UniformSections = 0;
+    f64 TotalNs = 0.0;
+
+    const glm::ivec3 NeighborOffsets[4] = {glm::ivec3(1, 0, 0), glm::ivec3(-1, 0, 0), glm::ivec3(0, 0, 1), glm::ivec3(0, 0, -1)};
+
+    for (u32 Repeat = 0; Repeat < Repeats; ++Repeat)
+    {
+        std::unordered_map<glm::ivec3, Chunk*, ChunkHash> Chunks;
+
+        for (const glm::ivec3& Position : Positions)
+        {
+            u64 AllocationsBefore = AllocationCount.load();
+            Clock::time_point Start = Clock::now();
+
+            Chunk* chunk = AllocateChunk(Position);
+            GenerateChunk(chunk);
+
+            Clock::time_point Generated = Clock::now();
+            GenerateAllocations += AllocationCount.load() - AllocationsBefore;
+            GenerateSamples.push_back(ElapsedNs(Start, Generated));
+            TotalNs += ElapsedNs(Start, Generated);
+
+            StorageBytes += ChunkStorageBytes(chunk);
+            for (const BlockSection& Section : chunk->Sections)
+            {
+                UniformSections += !Section.Bits;
+            }
+
+            Chunks[Position] = chunk;
+        }
+
+        for (const glm::ivec3& Position : Positions)
+        {
+            const Chunk* Neighbors[4];
+            for (u8 i = 0; i < 4; ++i)
+            {
+                auto it = Chunks.find(Position + NeighborOffsets[i]);
+                Neighbors[i] = it != Chunks.end() ? it->second : nullptr;
+            }
+
+            u64 AllocationsBefore = AllocationCount.load();
+            u64 BytesBefore = AllocationBytes.load();
+            Clock::time_point Start = Clock::now();
+
+            ChunkMesh* Mesh = new ChunkMesh;
+            SnapshotChunk(Chunks[Position], Neighbors, Mesh);
+            Mesh->Mode = Mode;
+            GenerateChunkMesh(Mesh);
+
+            Clock::time_point Meshed = Clock::now();
+            MeshAllocations += AllocationCount.load() - AllocationsBefore;
+            MeshBytes += AllocationBytes.load() - BytesBefore;
+            MeshSamples.push_back(ElapsedNs(Start, Meshed));
+            TotalNs += ElapsedNs(Start, Meshed);
+
+            TotalVertices += Mesh->Vertices.size();
+            TotalIndices += Mesh->Vertices.size() / 4 * 6;
+
+            delete Mesh;
+        }
+
+        for (auto& [Position, chunk] : Chunks)
+        {
+            delete chunk;
+        }
+    }
+
+    f64 ChunkCount = (f64)GenerateSamples.size();
+    f64 Voxels = (f64)(CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE);
+    Percentiles Generate = ComputePercentiles(GenerateSamples);
+    Percentiles Meshing = ComputePercentiles(MeshSamples);
+
+    printf("[%s/%s] %zu chunks x %u repeats\n", Name, Mode == MeshingMode::GREEDY ? "greedy" : "naive", Positions.size(), Repeats);
+    printf("  throughput             %9.1f chunks/sec (generate + mesh)\n", ChunkCount / (TotalNs * 1e-9));
+    PrintPercentiles("GenerateChunk", Generate, 1e3, "us");
+    PrintPercentiles("Snapshot + Mesh", Meshing, 1e3, "us");
+    printf("  GenerateChunk          %9.2f ns/voxel\n", Generate.Mean / Voxels);
+    printf("  Snapshot + Mesh        %9.2f ns/voxel\n", Meshing.Mean / Voxels);
+    printf("  vertices/chunk         %9.1f\n", TotalVertices / ChunkCount);
+    printf("  triangles/chunk        %9.1f\n", TotalIndices / 3 / ChunkCount);
+    printf("  mesh bytes/chunk       %9.1f KB (vertices only, %.1f KB of 32-bit indices shared away)\n",
+        TotalVertices * sizeof(ChunkVertex) / ChunkCount / 1024.0, TotalIndices * sizeof(u32) / ChunkCount / 1024.0);
+    printf("  block bytes/chunk      %9.1f KB (%.1f KB dense, %.1f of %d sections uniform)\n",
+        StorageBytes / ChunkCount / 1024.0, Voxels / 1024.0, UniformSections / ChunkCount, SECTION_COUNT);
+    printf("  allocations/chunk      %9.1f generate, %.1f mesh (%.1f KB)\n",
+        GenerateAllocations / ChunkCount, MeshAllocations / ChunkCount, MeshBytes / ChunkCount / 1024.0);
+    printf("\n");
+}
+
+// Full Square Ring Loaded Around the Spawn Chunk, Same Shape as LoadChunks
+// Radius Stays at the Old Full Detail Render Distance so Results Compare Across Versions
+static void RunSpawnScenario(u32 Repeats)
+{
+    const s32 Radius = 16;
+
+    std::vector<glm::ivec3> Positions;
+    for (s32 x = -Radius; x <= Radius; ++x)
+    {
+        for (s32 z = -Radius; z <= Radius; ++z)
+        {
+            Positions.push_back(glm::ivec3(x, 0, z));
+        }
+    }
+
+    RunChunkScenario("spawn", Positions, Repeats, MeshingMode::NAIVE);
+    RunChunkScenario("spawn", Positions, Repeats, MeshingMode::GREEDY);
+}
+
+// Rows Streamed in While Sprinting Along +X for 32 Chunk Borders
+static void RunSprintScenario(u32 Repeats)
+{
+    const s32 Radius = 16;
+
+    std::vector<glm::ivec3> Positions;
+    for (s32 Step = 1; Step <= 32; ++Step)
+    {
+        for (s32 z = -Radius; z <= Radius; ++z)
+        {
+            Positions.push_back(glm::ivec3(Radius + Step, 0, z));
+        }
+    }
+
+    RunChunkScenario("sprint", Positions, Repeats, MeshingMode::NAIVE);
+    RunChunkScenario("sprint", Positions, Repeats, MeshingMode::GREEDY);
+}
+
+// Remesh After a Surface Edit, Whole Column Against Just the Sections SetBlock Would Queue
+static void RunEditScenario(u32 Repeats)
+{
+    const s32 Extent = 5;
+    const glm::ivec3 NeighborOffsets[4] = {glm::ivec3(1, 0, 0), glm::ivec3(-1, 0, 0), glm::ivec3(0, 0, 1), glm::ivec3(0, 0, -1)};
+
+    std::unordered_map<glm::ivec3, Chunk*, ChunkHash> Chunks;
+    for (s32 x = -Extent; x <= Extent; ++x)
+    {
+        for (s32 z = -Extent; z <= Extent; ++z)
+        {
+            Chunk* chunk = AllocateChunk(glm::ivec3(x, 0, z));
+            GenerateChunk(chunk);
+            Chunks[chunk->Position] = chunk;
+        }
+    }
+
+    for (u8 Mode = MeshingMode::NAIVE; Mode <= MeshingMode::GREEDY; ++Mode)
+    {
+        std::vector<f64> ColumnSamples;
+        std::vector<f64> SectionSamples;
+        ChunkMesh* Mesh = new ChunkMesh();
+
+        for (u32 Repeat = 0; Repeat < Repeats; ++Repeat)
+        {
+            for (s32 x = 1 - Extent; x < Extent; ++x)
+            {
+                for (s32 z = 1 - Extent; z < Extent; ++z)
+                {
+                    Chunk* chunk = Chunks[glm::ivec3(x, 0, z)];
+                    const Chunk* Neighbors[4];
+                    for (u8 i = 0; i < 4; ++i)
+                    {
+                        Neighbors[i] = Chunks[chunk->Position + NeighborOffsets[i]];
+                    }
+
+                    // Edit Lands on the Surface Block in the Middle of the Chunk
+                    u8 y = CHUNK_HEIGHT - 1;
+                    while (y > 0 && !GetChunkBlock(chunk, 8, y, 8)) y--;
+
+                    u8 Section = y / SECTION_SIZE;
+                    u8 Sections = 1 << Section;
+                    if (y % SECTION_SIZE == 0 && Section > 0) Sections |= 1 << (Section - 1);
+                    if (y % SECTION_SIZE == SECTION_SIZE - 1 && Section < SECTION_COUNT - 1) Sections |= 1 << (Section + 1);
+
+                    const u8 Masks[2] = {ALL_SECTIONS, Sections};
+                    for (u8 m = 0; m < 2; ++m)
+                    {
+                        Clock::time_point Start = Clock::now();
+                        SnapshotChunk(chunk, Neighbors, Mesh, Masks[m]);
+                        Mesh->Mode = Mode;
+                        GenerateChunkMesh(Mesh);
+                        (m ? SectionSamples : ColumnSamples).push_back(ElapsedNs(Start, Clock::now()));
+                    }
+                }
+            }
+        }
+        delete Mesh;
+
+        Percentiles Column = ComputePercentiles(ColumnSamples);
+        Percentiles Sections = ComputePercentiles(SectionSamples);
+        printf("[edit/%s] %zu edits\n", Mode == MeshingMode::GREEDY ? "greedy" : "naive", ColumnSamples.size());
+        PrintPercentiles("whole column", Column, 1e3, "us");
+        PrintPercentiles("edited sections", Sections, 1e3, "us");
+        printf("  speedup                %9.2fx (p50)\n", Column.P50 / Sections.P50);
+        printf("\n");
+    }
+
+    for (auto& [Position, chunk] : Chunks)
+    {
+        delete chunk;
+    }
+}
+
+// Chunks Saved to a Scratch Region File, Then Loaded Back Against Regenerating Them
+static void RunRegionScenario(u32 Repeats)
+{
+    std::filesystem::path Directory = std::filesystem::temp_directory_path() / "voxelbench_world";
+    std::filesystem::create_directories(Directory);
+    std::string Path = (Directory / "r.0.0.bin").string();
+    std::filesystem::remove(Path);
+
+    RegionFile Region;
+    if (!Region.Open(Path.c_str()))
+    {
+        printf("[region] could not open %s\n\n", Path.c_str());
+        return;
+    }
+
+    std::vector<Chunk*> Chunks;
+    std::vector<u8> Raw, Compressed;
+    u64 RawBytes = 0;
+    u64 StoredBytes = 0;
+    for (s32 x = 0; x < REGION_SIZE; ++x)
+    {
+        for (s32 z = 0; z < REGION_SIZE; ++z)
+        {
+            Chunk* chunk = AllocateChunk(glm::ivec3(x, 0, z));
+            GenerateChunk(chunk);
+            Chunks.push_back(chunk);
+
+            SerializeChunk(chunk, Raw);
+            CompressPayload(Raw, Compressed);
+            Region.Write(GetRegionIndex(chunk->Position), Compressed);
+            RawBytes += Raw.size();
+            StoredBytes += Compressed.size();
+        }
+    }
+
+    std::vector<f64> LoadSamples;
+    std::vector<f64> GenerateSamples;
+    u64 Mismatches = 0;
+    for (u32 Repeat = 0; Repeat < Repeats; ++Repeat)
+    {
+        for (Chunk* Original : Chunks)
+        {
+            Chunk* Loaded = AllocateChunk(Original->Position);
+            Clock::time_point Start = Clock::now();
+            u32 Size = 0;
+            const u8* Data = Region.Read(GetRegionIndex(Original->Position), &Size);
+            bool Ok = Data && DecompressPayload(Data, Size, Raw) && DeserializeChunk(Raw.data(), Raw.size(), Loaded);
+            LoadSamples.push_back(ElapsedNs(Start, Clock::now()));
+
+            Chunk* Generated = AllocateChunk(Original->Position);
+            Start = Clock::now();
+            GenerateChunk(Generated);
+            GenerateSamples.push_back(ElapsedNs(Start, Clock::now()));
+
+            for (u8 y = 0; y < CHUNK_HEIGHT && Ok; ++y)
+            {
+                for (u8 z = 0; z < CHUNK_SIZE; ++z)
+                {
+                    for (u8 x = 0; x < CHUNK_SIZE; ++x)
+                    {
+                        Mismatches += GetChunkBlock(Loaded, x, y, z) != GetChunkBlock(Original, x, y, z);
+                    }
+                }
+            }
+            Mismatches += !Ok;
+
+            delete Loaded;
+            delete Generated;
+        }
+    }
+
+    Region.Close();
+    std::filesystem::remove(Path);
+    for (Chunk* chunk : Chunks) delete chunk;
+
+    Percentiles Load = ComputePercentiles(LoadSamples);
+    Percentiles Generate = ComputePercentiles(GenerateSamples);
+    printf("[region] %zu chunks x %u repeats\n", Chunks.size(), Repeats);
+    PrintPercentiles("load (mmap)", Load, 1e3, "us");
+    PrintPercentiles("GenerateChunk", Generate, 1e3, "us");
+    printf("  speedup                %9.2fx (p50)\n", Generate.P50 / Load.P50);
+    printf("  stored bytes/chunk     %9.1f KB (%.1f KB serialized)\n", StoredBytes / (f64)Chunks.size() / 1024.0, RawBytes / (f64)Chunks.size() / 1024.0);
+    printf("  mismatched blocks      %9llu\n", (unsigned long long)Mismatches);
+    if (Mismatches) FailedChecks++;
+    printf("\n");
+}
+
+static void RunHeightMapScenario(u32 Repeats)
+{
+    const s32 Extent = 8;
+    std::vector<f64> Samples;
+    u64 Checksum = 0;
+
+    Chunk* chunk = AllocateChunk(glm::ivec3(0));
+    u8 HeightMap[CHUNK_SIZE * CHUNK_SIZE];
+    for (u32 Repeat = 0; Repeat < Repeats; ++Repeat)
+    {
+        for (s32 cx = -Extent; cx < Extent; ++cx)
+        {
+            for (s32 cz = -Extent; cz < Extent; ++cz)
+            {
+                chunk->Position = glm::ivec3(cx, 0, cz);
+
+                Clock::time_point Start = Clock::now();
+                GenerateHeightMap(chunk, HeightMap);
+                Samples.push_back(ElapsedNs(Start, Clock::now()));
+
+                for (u16 i = 0; i < CHUNK_SIZE * CHUNK_SIZE; ++i)
+                {
+                    Checksum += HeightMap[i];
+                }
+            }
+        }
+    }
+    delete chunk;
+
+    Percentiles PerChunk = ComputePercentiles(Samples);
+    printf("[heightmap] %zu column grids (checksum %llu)\n", Samples.size(), (unsigned long long)Checksum);
+    PrintPercentiles("GenerateHeightMap", PerChunk, 1e3, "us");
+    printf("  GenerateHeightMap      %9.2f ns/column\n", PerChunk.Mean / (CHUNK_SIZE * CHUNK_SIZE));
+    printf("\n");
+}
+
+static void RunAddFaceScenario(u32 Repeats)
+{
+    const u32 FacesPerBatch = 16384;
+    std::vector<f64> Samples;
+
+    ChunkMesh* Mesh = new ChunkMesh();
+    glm::vec3 p1(0.0f), p2(1.0f, 0.0f, 0.0f), p3(1.0f, 1.0f, 0.0f), p4(0.0f, 1.0f, 0.0f);
+
+    for (u32 Repeat = 0; Repeat < Repeats * 8; ++Repeat)
+    {
+        Mesh->Vertices.clear();
+        Mesh->Vertices.shrink_to_fit();
+
+        Clock::time_point Start = Clock::now();
+        for (u32 i = 0; i < FacesPerBatch; ++i)
+        {
+            AddFace(Mesh, p1, p2, p3, p4, BlockFace::FRONT, UVTable[BlockType::STONE - 1].Side);
+        }
+        Samples.push_back(ElapsedNs(Start, Clock::now()) / FacesPerBatch);
+    }
+    delete Mesh;
+
+    printf("[addface] %u faces x %zu batches\n", FacesPerBatch, Samples.size());
+    PrintPercentiles("AddFace", ComputePercentiles(Samples), 1.0, "ns/face");
+    printf("\n");
+}
+
+// Frustum Test of a Radius 32 Chunk Grid From a Camera Turning in Place
+static void RunCullScenario(u32 Repeats)
+{
+    const s32 Radius = 32;
+    const u32 Frames = 256;
+
+    BoxList Boxes;
+    for (s32 x = -Radius; x <= Radius; ++x)
+    {
+        for (s32 z = -Radius; z <= Radius; ++z)
+        {
+            // Heights Vary per Chunk Like Real Terrain Bounds Do
+            f32 MinY = (f32)((x * 7 + z * 13) & 15);
+            f32 MaxY = MinY + 40.0f + (f32)((x * 5 - z * 3) & 31);
+            Boxes.Add(glm::vec3(x * CHUNK_SIZE, MinY, z * CHUNK_SIZE), glm::vec3(x * CHUNK_SIZE + CHUNK_SIZE, MaxY, z * CHUNK_SIZE + CHUNK_SIZE));
+        }
+    }
+
+    glm::mat4 Projection = glm::perspective(glm::radians(60.0f), 1280.0f / 720.0f, 0.1f, 10000.0f);
+    Frustum ViewFrustum;
+    std::vector<u8> Visible;
+    std::vector<f64> Samples;
+    u64 VisibleTotal = 0;
+
+    for (u32 Repeat = 0; Repeat < Repeats; ++Repeat)
+    {
+        for (u32 Frame = 0; Frame < Frames; ++Frame)
+        {
+            f32 Yaw = glm::radians(360.0f * Frame / Frames);
+            glm::vec3 Eye(0.0f, 70.0f, 0.0f);
+            glm::mat4 View = glm::lookAt(Eye, Eye + glm::vec3(cosf(Yaw), -0.2f, sinf(Yaw)), glm::vec3(0.0f, 1.0f, 0.0f));
+
+            Clock::time_point Start = Clock::now();
+            ViewFrustum.Update(Projection * View);
+            ViewFrustum.Cull(Boxes, Visible);
+            Samples.push_back(ElapsedNs(Start, Clock::now()));
+
+            for (u8 v : Visible) VisibleTotal += v;
+        }
+    }
+
+    printf("[cull] %zu chunk boxes x %zu frames\n", Boxes.Size(), Samples.size());
+    PrintPercentiles("Update + Cull", ComputePercentiles(Samples), 1e3, "us");
+    printf("  per box                %9.2f ns\n", ComputePercentiles(Samples).Mean / Boxes.Size());
+    printf("  visible                %9.1f %%\n", 100.0 * VisibleTotal / ((f64)Boxes.Size() * Samples.size()));
+    printf("\n");
+}
+
+// Spawn Ring Generated Through WorkerPool at Increasing Worker Counts
+static void RunWorkersScenario(u32 Repeats)
+{
+    const s32 Radius = 16;
+
+    std::vector<glm::ivec3> Positions;
+    for (s32 x = -Radius; x <= Radius; ++x)
+    {
+        for (s32 z = -Radius; z <= Radius; ++z)
+        {
+            Positions.push_back(glm::ivec3(x, 0, z));
+        }
+    }
+
+    u32 MaxWorkers = std::thread::hardware_concurrency();
+    if (MaxWorkers == 0) MaxWorkers = 1;
+
+    printf("[workers] %zu chunks x %u repeats, GenerateChunk only\n", Positions.size(), Repeats);
+    f64 SingleWorkerRate = 0.0;
+    for (u32 WorkerCount = 1; WorkerCount <= MaxWorkers; WorkerCount = WorkerCount < MaxWorkers && WorkerCount * 2 > MaxWorkers ? MaxWorkers : WorkerCount * 2)
+    {
+        std::vector<f64> Samples;
+        for (u32 Repeat = 0; Repeat < Repeats; ++Repeat)
+        {
+            std::vector<Chunk*> Chunks;
+            for (const glm::ivec3& Position : Positions)
+            {
+                Chunks.push_back(AllocateChunk(Position));
+            }
+
+            std::mutex DoneMutex;
+            std::condition_variable DoneSignal;
+            size_t Done = 0;
+
+            WorkerPool Pool;
+            Clock::time_point Start = Clock::now();
+            Pool.Start(WorkerCount);
+            for (Chunk* chunk : Chunks)
+            {
+                Pool.Submit(chunk->Position, [chunk, &DoneMutex, &DoneSignal, &Done]
+                {
+                    GenerateChunk(chunk);
+
+                    std::lock_guard<std::mutex> Lock(DoneMutex);
+                    Done++;
+                    DoneSignal.notify_one();
+                });
+            }
+            {
+                std::unique_lock<std::mutex> Lock(DoneMutex);
+                DoneSignal.wait(Lock, [&] { return Done == Chunks.size(); });
+            }
+            Samples.push_back(ElapsedNs(Start, Clock::now()));
+            Pool.Stop();
+
+            for (Chunk* chunk : Chunks) delete chunk;
+        }
+
+        f64 Rate = Positions.size() / (ComputePercentiles(Samples).P50 * 1e-9);
+        if (WorkerCount == 1) SingleWorkerRate = Rate;
+        printf("  %2u workers            %9.1f chunks/sec (%.2fx)\n", WorkerCount, Rate, Rate / SingleWorkerRate);
+
+        if (WorkerCount == MaxWorkers) break;
+    }
+    printf("\n");
+}
+
+// Chunk Directory Lookups & Iteration: Node Map With the Old Hash, Node Map With ChunkHash, ChunkGrid
+static void RunDirectoryScenario(u32 Repeats)
+{
+    const s32 Radius = RENDER_DISTANCE + UNLOAD_MARGIN;
+    const u32 Lookups = 1 << 20;
+
+    // Hash the Directory Used Before ChunkGrid
+    struct LegacyHash
+    {
+        size_t operator()(const glm::ivec3& pos) const
+        {
+            return std::hash<int>()(pos.x) ^ (std::hash<int>()(pos.y) << 1) ^ (std::hash<int>()(pos.z) << 2);
+        }
+    };
+
+    std::vector<Chunk*> Chunks;
+    std::unordered_map<glm::ivec3, Chunk*, LegacyHash> LegacyMap;
+    std::unordered_map<glm::ivec3, Chunk*, ChunkHash> HashedMap;
+    ChunkGrid Grid;
+    Grid.Resize(Radius);
+    for (s32 x = -Radius; x <= Radius; ++x)
+    {
+        for (s32 z = -Radius; z <= Radius; ++z)
+        {
+            Chunk* chunk = AllocateChunk(glm::ivec3(x, 0, z));
+            Chunks.push_back(chunk);
+            LegacyMap[chunk->Position] = chunk;
+            HashedMap[chunk->Position] = chunk;
+            Grid.Insert(chunk);
+        }
+    }
+
+    // Neighbor Style Probes Drifting Across the Square, Some Fall Just Outside It
+    std::vector<glm::ivec3> Probes(Lookups);
+    u32 Seed = 12345;
+    glm::ivec3 Walk(0);
+    for (glm::ivec3& Probe : Probes)
+    {
+        Seed = Seed * 1664525u + 1013904223u;
+        Walk.x = glm::clamp(Walk.x + (s32)((Seed >> 8) % 3) - 1, -Radius - 1, Radius + 1);
+        Walk.z = glm::clamp(Walk.z + (s32)((Seed >> 16) % 3) - 1, -Radius - 1, Radius + 1);
+        Probe = Walk;
+    }
+
+    std::vector<f64> LegacyFind, HashedFind, GridFind, LegacyIterate, HashedIterate, GridIterate;
+    u64 Found = 0;
+    for (u32 Repeat = 0; Repeat < Repeats; ++Repeat)
+    {
+        Clock::time_point Start = Clock::now();
+        for (const glm::ivec3& Probe : Probes) { auto it = LegacyMap.find(Probe); Found += it != LegacyMap.end(); }
+        LegacyFind.push_back(ElapsedNs(Start, Clock::now()) / Lookups);
+
+        Start = Clock::now();
+        for (const glm::ivec3& Probe : Probes) { auto it = HashedMap.find(Probe); Found += it != HashedMap.end(); }
+        HashedFind.push_back(ElapsedNs(Start, Clock::now()) / Lookups);
+
+        Start = Clock::now();
+        for (const glm::ivec3& Probe : Probes) Found += Grid.Find(Probe) != nullptr;
+        GridFind.push_back(ElapsedNs(Start, Clock::now()) / Lookups);
+
+        // Iteration Touches Each Chunk the Way RenderWorld Does
+        Start = Clock::now();
+        for (auto& [key, chunk] : LegacyMap) Found += chunk->Meshes[0].Revision;
+        LegacyIterate.push_back(ElapsedNs(Start, Clock::now()));
+
+        Start = Clock::now();
+        for (auto& [key, chunk] : HashedMap) Found += chunk->Meshes[0].Revision;
+        HashedIterate.push_back(ElapsedNs(Start, Clock::now()));
+
+        Start = Clock::now();
+        for (Chunk* chunk : Grid.Cells) if (chunk) Found += chunk->Meshes[0].Revision;
+        GridIterate.push_back(ElapsedNs(Start, Clock::now()));
+    }
+
+    size_t LongestBucket = 0;
+    for (size_t Bucket = 0; Bucket < LegacyMap.bucket_count(); ++Bucket) LongestBucket = std::max(LongestBucket, LegacyMap.bucket_size(Bucket));
+    size_t HashedLongest = 0;
+    for (size_t Bucket = 0; Bucket < HashedMap.bucket_count(); ++Bucket) HashedLongest = std::max(HashedLongest, HashedMap.bucket_size(Bucket));
+
+    printf("[directory] %zu chunks, %u lookups x %u repeats, grid side %d (found %llu)\n", Chunks.size(), Lookups, Repeats, Grid.Side, (unsigned long long)Found);
+    PrintPercentiles("Find (legacy hash)", ComputePercentiles(LegacyFind), 1.0, "ns");
+    PrintPercentiles("Find (ChunkHash)", ComputePercentiles(HashedFind), 1.0, "ns");
+    PrintPercentiles("Find (ChunkGrid)", ComputePercentiles(GridFind), 1.0, "ns");
+    PrintPercentiles("Iterate (legacy hash)", ComputePercentiles(LegacyIterate), 1e3, "us");
+    PrintPercentiles("Iterate (ChunkHash)", ComputePercentiles(HashedIterate), 1e3, "us");
+    PrintPercentiles("Iterate (ChunkGrid)", ComputePercentiles(GridIterate), 1e3, "us");
+    printf("  longest bucket         legacy %zu, ChunkHash %zu\n", LongestBucket, HashedLongest);
+    printf("\n");
+
+    for (Chunk* chunk : Chunks) delete chunk;
+}
+
+// Player Walking in a Straight Line: Each Step Drops the Column Behind, Generates the One Ahead
+// and Meshes it Along With the Column it Now Borders. Run With new/delete, Then Through ChunkPool
+static void RunStreamScenario(u32 Repeats)
+{
+    const s32 Radius = 8;
+    const s32 WarmSteps = 4 * Radius;
+    const s32 Steps = WarmSteps + 64;
+    const glm::ivec3 NeighborOffsets[4] = {glm::ivec3(1, 0, 0), glm::ivec3(-1, 0, 0), glm::ivec3(0, 0, 1), glm::ivec3(0, 0, -1)};
+
+    for (u32 Pooled = 0; Pooled < 2; ++Pooled)
+    {
+        std::vector<f64> Samples;
+        u64 Allocations = 0;
+        u64 StorageBytes = 0;
+
+        for (u32 Repeat = 0; Repeat < Repeats; ++Repeat)
+        {
+            ChunkGrid Grid;
+            Grid.Resize(Radius + 1);
+
+            auto Load = [&](glm::ivec3 Position)
+            {
+                Chunk* chunk = Pooled ? AcquireChunk() : new Chunk();
+                chunk->Position = Position;
+                GenerateChunk(chunk);
+                chunk->State = ChunkState::GENERATED;
+                Grid.Insert(chunk);
+            };
+            auto Unload = [&](glm::ivec3 Position)
+            {
+                Chunk* chunk = Grid.Find(Position);
+                Grid.Erase(Position);
+                if (Pooled) ReleaseChunk(chunk);
+                else delete chunk;
+            };
+            auto Mesh = [&](glm::ivec3 Position)
+            {
+                const Chunk* Neighbors[4];
+                for (u8 i = 0; i < 4; ++i) Neighbors[i] = Grid.Find(Position + NeighborOffsets[i]);
+
+                ChunkMesh* Job = Pooled ? AcquireChunkMesh() : new ChunkMesh();
+                SnapshotChunk(Grid.Find(Position), Neighbors, Job);
+                Job->Mode = MeshingMode::GREEDY;
+                GenerateChunkMesh(Job);
+                if (Pooled) ReleaseChunkMesh(Job);
+                else delete Job;
+            };
+
+            for (s32 x = -Radius; x <= Radius; ++x)
+            {
+                for (s32 z = -Radius; z <= Radius; ++z) Load(glm::ivec3(x, 0, z));
+            }
+
+            for (s32 Step = 1; Step <= Steps; ++Step)
+            {
+                u64 AllocationsBefore = AllocationCount.load();
+                Clock::time_point Start = Clock::now();
+
+                for (s32 z = -Radius; z <= Radius; ++z)
+                {
+                    Unload(glm::ivec3(Step - 1 - Radius, 0, z));
+                    Load(glm::ivec3(Step + Radius, 0, z));
+                }
+                for (s32 z = -Radius; z <= Radius; ++z)
+                {
+                    Mesh(glm::ivec3(Step + Radius, 0, z));
+                    Mesh(glm::ivec3(Step + Radius - 1, 0, z));
+                }
+
+                // Early Steps Fill the Pool & Grow its Vectors, Only the Steady State After That is Counted
+                // Counted Before the Sample is Stored, Growing Samples Isn't Part of the Step
+                if (Step > WarmSteps)
+                {
+                    f64 Elapsed = ElapsedNs(Start, Clock::now());
+                    Allocations += AllocationCount.load() - AllocationsBefore;
+                    Samples.push_back(Elapsed);
+                }
+            }
+
+            for (Chunk* chunk : Grid.Cells)
+            {
+                if (!chunk) continue;
+                StorageBytes += ChunkStorageBytes(chunk);
+                if (Pooled) ReleaseChunk(chunk);
+                else delete chunk;
+            }
+        }
+        if (Pooled) ClearChunkPool();
+
+        f64 ChunkCount = (f64)Repeats * (2 * Radius + 1) * (2 * Radius + 1);
+        printf("[stream/%s] %zu steps x %d chunks, radius %d\n", Pooled ? "pooled" : "new", Samples.size(), 2 * Radius + 1, Radius);
+        PrintPercentiles("Step", ComputePercentiles(Samples), 1e3, "us");
+        printf("  allocations/step       %9.2f\n", (f64)Allocations / Samples.size());
+        printf("  block bytes/chunk      %9.1f KB (capacity)\n", StorageBytes / ChunkCount / 1024.0);
+        printf("\n");
+    }
+}
+
+// Reach Rays From Random Eye Points Over Generated Terrain: Single Casts, One Batch, and the
+// Old Fixed 0.01 March Run Alongside as Reference for Speed & for Blocks it Misses
+static void RunRaycastScenario(u32 Repeats)
+{
+    const s32 Radius = 3;
+    const u32 RayCount = 4096;
+    const f32 Reach = 64.0f;
+
+    ChunkGrid Grid;
+    Grid.Resize(Radius);
+    std::vector<Chunk*> Chunks;
+    for (s32 x = -Radius; x <= Radius; ++x)
+    {
+        for (s32 z = -Radius; z <= Radius; ++z)
+        {
+            Chunk* chunk = AllocateChunk(glm::ivec3(x, 0, z));
+            GenerateChunk(chunk);
+            chunk->State = ChunkState::GENERATED;
+            Chunks.push_back(chunk);
+            Grid.Insert(chunk);
+        }
+    }
+
+    // Looking Down & Around From Inside the Middle Chunks so Most Rays Reach the Ground
+    std::vector<Ray> Rays(RayCount);
+    u32 Seed = 777;
+    auto Random = [&Seed]() { Seed = Seed * 1664525u + 1013904223u; return (Seed >> 8) / 16777216.0f; };
+    for (Ray& ray : Rays)
+    {
+        ray.Origin = glm::vec3((Random() - 0.5f) * CHUNK_SIZE * 2, 40.0f + Random() * 60.0f, (Random() - 0.5f) * CHUNK_SIZE * 2);
+        ray.Direction = glm::normalize(glm::vec3(Random() - 0.5f, -Random(), Random() - 0.5f));
+        ray.MaxDistance = Reach;
+    }
+
+    auto March = [&Grid](const Ray& ray, glm::ivec3* Block)
+    {
+        for (f32 Reached = 0.0f; Reached < ray.MaxDistance; Reached += 0.01f)
+        {
+            glm::vec3 Point = ray.Origin + ray.Direction * Reached;
+            glm::ivec3 Test(floor_(Point.x + BLOCK_RENDER_SIZE), floor_(Point.y + BLOCK_RENDER_SIZE), floor_(Point.z + BLOCK_RENDER_SIZE));
+            if (Test.y < 0 || Test.y >= CHUNK_HEIGHT) continue;
+
+            Chunk* chunk = Grid.Find(glm::ivec3(GetBlockChunk(Test.x), 0, GetBlockChunk(Test.z)));
+            if (chunk && GetChunkBlock(chunk, Test.x - chunk->Position.x * CHUNK_SIZE, Test.y, Test.z - chunk->Position.z * CHUNK_SIZE))
+            {
+                *Block = Test;
+                return true;
+            }
+        }
+        return false;
+    };
+
+    std::vector<RayHit> Hits(RayCount);
+    std::vector<f64> SingleSamples, BatchSamples, MarchSamples;
+    u32 HitCount = 0, Disagree = 0, Missed = 0;
+    for (u32 Repeat = 0; Repeat < Repeats; ++Repeat)
+    {
+        Clock::time_point Start = Clock::now();
+        for (u32 i = 0; i < RayCount; ++i) RaycastBlocks(Grid, Rays[i], &Hits[i]);
+        SingleSamples.push_back(ElapsedNs(Start, Clock::now()) / RayCount);
+
+        Start = Clock::now();
+        RaycastBlocks(Grid, Rays.data(), Hits.data(), RayCount);
+        BatchSamples.push_back(ElapsedNs(Start, Clock::now()) / RayCount);
+
+        std::vector<glm::ivec3> Marched(RayCount);
+        std::vector<u8> MarchHit(RayCount);
+        Start = Clock::now();
+        for (u32 i = 0; i < RayCount; ++i) MarchHit[i] = March(Rays[i], &Marched[i]);
+        MarchSamples.push_back(ElapsedNs(Start, Clock::now()) / RayCount);
+
+        HitCount = 0, Disagree = 0, Missed = 0;
+        for (u32 i = 0; i < RayCount; ++i)
+        {
+            HitCount += Hits[i].Hit;
+            // Every Point the March Samples Lies in a Block the Traversal Visits, so it Can Only Hit Later or Not at All
+            bool MarchLater = MarchHit[i] && glm::dot(glm::vec3(Marched[i]) - Rays[i].Origin, Rays[i].Direction) > Hits[i].Distance;
+            if (Hits[i].Hit && (!MarchHit[i] || (Hits[i].Block != Marched[i] && MarchLater))) Missed++;
+            else if (Hits[i].Hit != (bool)MarchHit[i] || (Hits[i].Hit && Hits[i].Block != Marched[i])) Disagree++;
+        }
+    }
+
+    printf("[raycast] %u rays x %u repeats, %.0f block reach, %zu chunks\n", RayCount, Repeats, Reach, Chunks.size());
+    PrintPercentiles("DDA single", ComputePercentiles(SingleSamples), 1.0, "ns/ray");
+    PrintPercentiles("DDA batch", ComputePercentiles(BatchSamples), 1.0, "ns/ray");
+    PrintPercentiles("0.01 march", ComputePercentiles(MarchSamples), 1.0, "ns/ray");
+    printf("  hits                   %9u (%u the march skipped past, %u other differences)\n", HitCount, Missed, Disagree);
+    printf("\n");
+
+    for (Chunk* chunk : Chunks) delete chunk;
+}
+
+// Diagnostics Overlay Batched for a Radius 32 Grid: Eight Section Boxes per Chunk Plus a Page of Text,
+// Cleared Between Frames the Way Flush Does. Only Batching is Timed, There's No GL Context to Upload To
+static void RunDebugDrawScenario(u32 Repeats)
+{
+    const s32 Radius = 32;
+    const u32 Frames = 64;
+    const char* Page = "16.7 MS\nCHUNKS 4225 RETAINED 0\nSECTIONS 12000 DRAWN 21800 CULLED\nDEBUG VERTICES 811200 DROPPED 0";
+
+    DebugDraw Batch;
+    std::vector<f64> Samples;
+    u64 Allocations = 0;
+    u32 Vertices = 0, Lines = 0;
+
+    for (u32 Frame = 0; Frame < Frames * Repeats; ++Frame)
+    {
+        u64 AllocationsBefore = AllocationCount.load();
+        Clock::time_point Start = Clock::now();
+
+        for (s32 x = -Radius; x <= Radius; ++x)
+        {
+            for (s32 z = -Radius; z <= Radius; ++z)
+            {
+                for (s32 Section = 0; Section < SECTION_COUNT; ++Section)
+                {
+                    glm::vec3 Min((f32)(x * CHUNK_SIZE), (f32)(Section * SECTION_SIZE), (f32)(z * CHUNK_SIZE));
+                    Batch.Box(Min, Min + glm::vec3((f32)CHUNK_SIZE, (f32)SECTION_SIZE, (f32)CHUNK_SIZE), glm::vec3(0.0f, 1.0f, 0.0f));
+                }
+            }
+        }
+        Batch.Text(glm::vec2(8.0f, 712.0f), Page, glm::vec3(1.0f));
+
+        Clock::time_point End = Clock::now();
+        Vertices = (u32)(Batch.Lines.size() + Batch.Triangles.size());
+        Lines = (u32)Batch.Lines.size() / 2;
+        Batch.Clear();
+
+        // First Frame Grows the Vectors, Later Ones Should Reuse Them
+        if (Frame) Allocations += AllocationCount.load() - AllocationsBefore;
+        Samples.push_back(ElapsedNs(Start, End));
+    }
+
+    printf("[debugdraw] %u vertices (%u lines) x %zu frames\n", Vertices, Lines, Samples.size());
+    PrintPercentiles("Batch", ComputePercentiles(Samples), 1e3, "us");
+    printf("  per line               %9.2f ns\n", ComputePercentiles(Samples).Mean / Lines);
+    printf("  allocations/frame      %9.2f\n", (f64)Allocations / (Samples.size() - 1));
+    printf("\n");
+}
+
+// Cost of an Empty Scoped Zone on One Thread & on Several at Once, Then of Dumping the Rings
+// Nearly All of a Zone is its Two Clock Reads. Build With PROFILER=0 to Compare Against Zones Compiled Out
+static void RunProfilerScenario(u32 Repeats)
+{
+    const u32 ZonesPerBatch = 1 << 16;
+    const u32 ThreadCount = std::max(1u, std::min(4u, std::thread::hardware_concurrency())); // Threads Sharing a Core Would Time Each Other's Slices
+    std::vector<f64> Single, Threaded;
+
+    const u32 Batches = Repeats * 8;
+
+    // First Batch on Each Thread Registers & Faults in its Ring, Only Later Ones are Counted
+    for (u32 Batch = 0; Batch <= Batches; ++Batch)
+    {
+        Clock::time_point Start = Clock::now();
+        for (u32 i = 0; i < ZonesPerBatch; ++i)
+        {
+            PROFILE_ZONE("BenchZone");
+        }
+        if (Batch) Single.push_back(ElapsedNs(Start, Clock::now()) / ZonesPerBatch);
+        PROFILE_FRAME_END();
+    }
+
+    std::mutex ThreadedMutex;
+    std::vector<std::thread> Threads;
+    for (u32 t = 0; t < ThreadCount; ++t)
+    {
+        Threads.emplace_back([&]
+        {
+            for (u32 Batch = 0; Batch <= Batches; ++Batch)
+            {
+                Clock::time_point Start = Clock::now();
+                for (u32 i = 0; i < ZonesPerBatch; ++i)
+                {
+                    PROFILE_ZONE("BenchThreadZone");
+                }
+                f64 Ns = ElapsedNs(Start, Clock::now()) / ZonesPerBatch;
+
+                std::lock_guard<std::mutex> Lock(ThreadedMutex);
+                if (Batch) Threaded.push_back(Ns);
+            }
+        });
+    }
+    for (std::thread& Thread : Threads) Thread.join();
+
+    std::string TracePath = (std::filesystem::temp_directory_path() / "voxelbench_profile.json").string();
+    Clock::time_point DumpStart = Clock::now();
+    bool Dumped = DumpProfileTrace(TracePath.c_str());
+    f64 DumpMs = ElapsedNs(DumpStart, Clock::now()) / 1e6;
+    uintmax_t TraceBytes = Dumped ? std::filesystem::file_size(TracePath) : 0;
+    std::filesystem::remove(TracePath);
+
+    printf("[profiler] %u zones x %u batches, %u threads, PROFILER=%d\n", ZonesPerBatch, Batches, ThreadCount, PROFILER);
+    PrintPercentiles("Zone (1 thread)", ComputePercentiles(Single), 1.0, "ns/zone");
+    PrintPercentiles("Zone (threads)", ComputePercentiles(Threaded), 1.0, "ns/zone");
+    printf("  trace dump             %9.2f ms (%.1f KB%s)\n", DumpMs, TraceBytes / 1024.0, Dumped ? "" : ", failed");
+    printf("\n");
+}
+
+// Spawn Square Meshed at Every Level Against Same Level Neighbors, Then the Per Level Averages Scaled Up to
+// the Bands ChunkLod Hands Out Across RENDER_DISTANCE, Against Meshing That Whole Square at Full Detail
+static void RunLodScenario(u32 Repeats)
+{
+    const s32 Radius = 16;
+    const glm::ivec3 NeighborOffsets[4] = {glm::ivec3(1, 0, 0), glm::ivec3(-1, 0, 0), glm::ivec3(0, 0, 1), glm::ivec3(0, 0, -1)};
+
+    std::unordered_map<glm::ivec3, Chunk*, ChunkHash> Chunks;
+    for (s32 x = -Radius - 1; x <= Radius + 1; ++x)
+    {
+        for (s32 z = -Radius - 1; z <= Radius + 1; ++z)
+        {
+            Chunk* chunk = AllocateChunk(glm::ivec3(x, 0, z));
+            GenerateChunk(chunk);
+            Chunks[chunk->Position] = chunk;
+        }
+    }
+
+    const f64 ChunkCount = (f64)((2 * Radius + 1) * (2 * Radius + 1));
+    f64 Triangles[LOD_COUNT] = {};
+    f64 VertexBytes[LOD_COUNT] = {};
+
+    printf("[lod] %.0f chunks x %u repeats per level, greedy\n", ChunkCount, Repeats);
+
+    ChunkMesh* Mesh = new ChunkMesh();
+    for (u8 Lod = 0; Lod < LOD_COUNT; ++Lod)
+    {
+        std::vector<f64> Samples;
+        u64 Vertices = 0;
+
+        for (u32 Repeat = 0; Repeat < Repeats; ++Repeat)
+        {
+            for (s32 x = -Radius; x <= Radius; ++x)
+            {
+                for (s32 z = -Radius; z <= Radius; ++z)
+                {
+                    glm::ivec3 Position(x, 0, z);
+                    const Chunk* Neighbors[4];
+                    for (u8 i = 0; i < 4; ++i) Neighbors[i] = Chunks[Position + NeighborOffsets[i]];
+
+                    Clock::time_point Start = Clock::now();
+                    SnapshotChunk(Chunks[Position], Neighbors, Mesh);
+                    Mesh->Mode = MeshingMode::GREEDY;
+                    Mesh->Lod = Lod;
+                    GenerateChunkMesh(Mesh);
+                    Samples.push_back(ElapsedNs(Start, Clock::now()));
+
+                    Vertices += Mesh->Vertices.size();
+                }
+            }
+        }
+
+        Triangles[Lod] = Vertices / 2.0 / ChunkCount / Repeats;
+        VertexBytes[Lod] = (f64)Vertices * sizeof(ChunkVertex) / ChunkCount / Repeats;
+
+        char Label[32];
+        snprintf(Label, sizeof(Label), "Mesh (lod %u)", Lod);
+        PrintPercentiles(Label, ComputePercentiles(Samples), 1e3, "us");
+        printf("  %-22s %9.1f triangles/chunk, %.1f KB/chunk\n", "", Triangles[Lod], VertexBytes[Lod] / 1024.0);
+    }
+    delete Mesh;
+
+    // Chunks per Level Across the Loaded Square, Counted With the Same Rule ChunkLod Uses
+    u64 Bands[LOD_COUNT] = {};
+    for (s32 x = -RENDER_DISTANCE; x <= RENDER_DISTANCE; ++x)
+    {
+        for (s32 z = -RENDER_DISTANCE; z <= RENDER_DISTANCE; ++z)
+        {
+            s32 Distance = std::max(std::abs(x), std::abs(z));
+            u8 Lod = 0;
+            for (s32 Reach = LOD_BASE_DISTANCE; Distance > Reach && Lod < LOD_COUNT - 1; Reach *= 2) Lod++;
+            Bands[Lod]++;
+        }
+    }
+
+    f64 BandTriangles = 0.0, BandBytes = 0.0;
+    for (u8 Lod = 0; Lod < LOD_COUNT; ++Lod)
+    {
+        BandTriangles += Bands[Lod] * Triangles[Lod];
+        BandBytes += Bands[Lod] * VertexBytes[Lod];
+        printf("  band lod %u              %9llu chunks\n", Lod, (unsigned long long)Bands[Lod]);
+    }
+    f64 Square = (f64)(2 * RENDER_DISTANCE + 1) * (2 * RENDER_DISTANCE + 1);
+    f64 OldSquare = (f64)(2 * Radius + 1) * (2 * Radius + 1);
+    printf("  distance %d, bands      %9.2f M triangles, %.1f MB vertices\n", RENDER_DISTANCE, BandTriangles / 1e6, BandBytes / (1024.0 * 1024.0));
+    printf("  distance %d, full       %9.2f M triangles, %.1f MB vertices\n", RENDER_DISTANCE, Square * Triangles[0] / 1e6, Square * VertexBytes[0] / (1024.0 * 1024.0));
+    printf("  distance %d, full       %9.2f M triangles, %.1f MB vertices\n", Radius, OldSquare * Triangles[0] / 1e6, OldSquare * VertexBytes[0] / (1024.0 * 1024.0));
+    printf("\n");
+
+    for (auto& [Position, chunk] : Chunks) delete chunk;
+}
+
+// Square Meshed Once for its Section Connectivity, Then Turned Full Circle From the Sky, Standing on the Ground
+// & Buried Below Sea Level. Compares Sections With Geometry in the Frustum Against Those the Walk Also Reaches
+static void RunOcclusionScenario(u32 Repeats)
+{
+    const s32 Radius = 12;
+    const u32 Frames = 64;
+    const glm::ivec3 NeighborOffsets[4] = {glm::ivec3(1, 0, 0), glm::ivec3(-1, 0, 0), glm::ivec3(0, 0, 1), glm::ivec3(0, 0, -1)};
+
+    std::unordered_map<glm::ivec3, Chunk*, ChunkHash> Chunks;
+    for (s32 x = -Radius - 1; x <= Radius + 1; ++x)
+    {
+        for (s32 z = -Radius - 1; z <= Radius + 1; ++z)
+        {
+            Chunk* chunk = AllocateChunk(glm::ivec3(x, 0, z));
+            GenerateChunk(chunk);
+            chunk->State = ChunkState::GENERATED;
+            Chunks[chunk->Position] = chunk;
+        }
+    }
+
+    // Stands in for UploadChunkMesh, Only the Fields the Walk & Draw List Read
+    ChunkGrid Grid;
+    Grid.Resize(Radius);
+    ChunkMesh* Mesh = new ChunkMesh();
+    std::vector<f64> ConnectivitySamples;
+    u32 OpenSections = 0, SealedSections = 0, MixedSections = 0;
+    for (s32 x = -Radius; x <= Radius; ++x)
+    {
+        for (s32 z = -Radius; z <= Radius; ++z)
+        {
+            glm::ivec3 Position(x, 0, z);
+            const Chunk* Neighbors[4];
+            for (u8 i = 0; i < 4; ++i) Neighbors[i] = Chunks[Position + NeighborOffsets[i]];
+
+            Chunk* chunk = Chunks[Position];
+            SnapshotChunk(chunk, Neighbors, Mesh);
+            Mesh->Mode = MeshingMode::GREEDY;
+            GenerateChunkMesh(Mesh);
+
+            for (u8 Section = 0; Section < SECTION_COUNT; ++Section)
+            {
+                Clock::time_point Start = Clock::now();
+                u16 Connectivity = ComputeSectionConnectivity(Mesh, Section);
+                ConnectivitySamples.push_back(ElapsedNs(Start, Clock::now()));
+
+                SectionMesh& Target = chunk->Meshes[Section];
+                Target.Uploaded = 1;
+                Target.Connectivity = Connectivity;
+                Target.IndexCount = (Mesh->VertexStart[Section + 1] - Mesh->VertexStart[Section]) / 4 * 6;
+                Target.MinY = Mesh->MinY[Section];
+                Target.MaxY = Mesh->MaxY[Section];
+
+                if (Connectivity == ALL_FACE_PAIRS) OpenSections++;
+                else if (!Connectivity) SealedSections++;
+                else MixedSections++;
+            }
+            Grid.Insert(chunk);
+        }
+    }
+    delete Mesh;
+
+    s32 Surface = CHUNK_HEIGHT - 1;
+    while (Surface > 0 && !GetChunkBlock(Chunks[glm::ivec3(0)], 8, (u8)Surface, 8)) Surface--;
+
+    typedef struct
+    {
+        const char* Name;
+        f32 Height;
+        f32 Pitch;
+    } OcclusionCamera;
+    const OcclusionCamera Cameras[3] =
+    {
+        {"sky", 120.0f, -30.0f},
+        {"ground", Surface + 2.0f, -5.0f},
+        {"buried", 20.0f, 0.0f},
+    };
+
+    printf("[occlusion] %zu chunks, %u frames x %u repeats per camera\n", Grid.Size(), Frames, Repeats);
+    PrintPercentiles("Connectivity", ComputePercentiles(ConnectivitySamples), 1e3, "us/section");
+    printf("  sections               %9u open, %u sealed, %u mixed\n", OpenSections, SealedSections, MixedSections);
+
+    glm::mat4 Projection = glm::perspective(glm::radians(80.0f), 1280.0f / 720.0f, 0.1f, 10000.0f);
+    Frustum ViewFrustum;
+    std::vector<OcclusionStep> Queue;
+    u32 Frame = 0;
+    for (const OcclusionCamera& Camera : Cameras)
+    {
+        std::vector<f64> Samples;
+        u64 InFrustum = 0, Reached = 0, TrianglesInFrustum = 0, TrianglesReached = 0;
+        u32 RayHits = 0, HiddenHits = 0;
+
+        for (u32 Repeat = 0; Repeat < Repeats; ++Repeat)
+        {
+            for (u32 Turn = 0; Turn < Frames; ++Turn)
+            {
+                f32 Yaw = glm::radians(360.0f * Turn / Frames);
+                glm::vec3 Eye(8.0f, Camera.Height, 8.0f);
+                glm::vec3 Forward(cosf(Yaw) * cosf(glm::radians(Camera.Pitch)), sinf(glm::radians(Camera.Pitch)), sinf(Yaw) * cosf(glm::radians(Camera.Pitch)));
+                glm::mat4 ViewProjection = Projection * glm::lookAt(Eye, Eye + Forward, glm::vec3(0.0f, 1.0f, 0.0f));
+                ViewFrustum.Update(ViewProjection);
+
+                Clock::time_point Start = Clock::now();
+                bool Occluding = WalkVisibleSections(Grid, ViewFrustum, Eye, ++Frame, Queue);
+                Samples.push_back(ElapsedNs(Start, Clock::now()));
+
+                // Whatever a Ray Through the View First Hits is Visible, its Section Must Have Been Reached
+                glm::mat4 Unproject = glm::inverse(ViewProjection);
+                for (u32 i = 0; i < 32 * 32; ++i)
+                {
+                    glm::vec4 Far = Unproject * glm::vec4((i % 32 + 0.5f) / 16.0f - 1.0f, (i / 32 + 0.5f) / 16.0f - 1.0f, 1.0f, 1.0f);
+                    Ray ray = {Eye, glm::normalize(glm::vec3(Far) / Far.w - Eye), CHUNK_SIZE * (f32)Radius};
+                    RayHit Hit;
+                    if (!RaycastBlocks(Grid, ray, &Hit) || Hit.Normal == glm::ivec3(0)) continue;
+
+                    RayHits++;
+                    if (Occluding && Hit.HitChunk->Meshes[Hit.Block.y / SECTION_SIZE].VisibleFrame != Frame) HiddenHits++;
+                }
+
+                for (Chunk* chunk : Grid.Cells)
+                {
+                    if (!chunk) continue;
+                    for (const SectionMesh& Section : chunk->Meshes)
+                    {
+                        if (!Section.IndexCount) continue;
+
+                        glm::vec3 Min(chunk->Position.x * CHUNK_SIZE - BLOCK_RENDER_SIZE, Section.MinY - BLOCK_RENDER_SIZE, chunk->Position.z * CHUNK_SIZE - BLOCK_RENDER_SIZE);
+                        glm::vec3 Max(Min.x + CHUNK_SIZE, Section.MaxY - BLOCK_RENDER_SIZE, Min.z + CHUNK_SIZE);
+                        if (!ViewFrustum.Touches(Min, Max)) continue;
+
+                        InFrustum++;
+                        TrianglesInFrustum += Section.IndexCount / 3;
+                        if (Occluding && Section.VisibleFrame != Frame) continue;
+                        Reached++;
+                        TrianglesReached += Section.IndexCount / 3;
+                    }
+                }
+            }
+        }
+
+        char Label[32];
+        snprintf(Label, sizeof(Label), "Walk (%s)", Camera.Name);
+        PrintPercentiles(Label, ComputePercentiles(Samples), 1e3, "us");
+        printf("  %-22s %9.1f %% of %.0f sections, %.1f %% of %.0fk triangles kept\n", "",
+            100.0 * Reached / std::max<u64>(InFrustum, 1), (f64)InFrustum / Samples.size(),
+            100.0 * TrianglesReached / std::max<u64>(TrianglesInFrustum, 1), TrianglesInFrustum / 1000.0 / Samples.size());
+        printf("  %-22s %9u of %u view ray hits in sections the walk missed\n", "", HiddenHits, RayHits);
+        if (HiddenHits) FailedChecks++;
+    }
+    printf("\n");
+
+    for (auto& [Position, chunk] : Chunks) delete chunk;
+}
+
+int main(int argc, char** argv)
+{
+    const char* Scenario = argc > 1 ? argv[1] : "all";
+    u32 Repeats = argc > 2 ? (u32)atoi(argv[2]) : 1;
+    if (Repeats == 0) Repeats = 1;
+
+    bool All = strcmp(Scenario, "all") == 0;
+    bool Ran = false;
+
+    printf("VoxelBench: seed %d, RENDER_DISTANCE %d, %zu byte vertices\n\n", NOISE_SEED, RENDER_DISTANCE, sizeof(ChunkVertex));
+
+    if (All || strcmp(Scenario, "heightmap") == 0) { RunHeightMapScenario(Repeats); Ran = true; }
+    if (All || strcmp(Scenario, "addface") == 0)   { RunAddFaceScenario(Repeats);   Ran = true; }
+    if (All || strcmp(Scenario, "spawn") == 0)     { RunSpawnScenario(Repeats);     Ran = true; }
+    if (All || strcmp(Scenario, "sprint") == 0)    { RunSprintScenario(Repeats);    Ran = true; }
+    if (All || strcmp(Scenario, "workers") == 0)   { RunWorkersScenario(Repeats);   Ran = true; }
+    if (All || strcmp(Scenario, "cull") == 0)      { RunCullScenario(Repeats);      Ran = true; }
+    if (All || strcmp(Scenario, "edit") == 0)      { RunEditScenario(Repeats);      Ran = true; }
+    if (All || strcmp(Scenario, "region") == 0)    { RunRegionScenario(Repeats);    Ran = true; }
+    if (All || strcmp(Scenario, "directory") == 0) { RunDirectoryScenario(Repeats); Ran = true; }
+    if (All || strcmp(Scenario, "stream") == 0)    { RunStreamScenario(Repeats);    Ran = true; }
+    if (All || strcmp(Scenario, "raycast") == 0)   { RunRaycastScenario(Repeats);   Ran = true; }
+    if (All || strcmp(Scenario, "debugdraw") == 0) { RunDebugDrawScenario(Repeats); Ran = true; }
+    if (All || strcmp(Scenario, "profiler") == 0)  { RunProfilerScenario(Repeats);  Ran = true; }
+    if (All || strcmp(Scenario, "lod") == 0)       { RunLodScenario(Repeats);       Ran = true; }
+    if (All || strcmp(Scenario, "occlusion") == 0) { RunOcclusionScenario(Repeats); Ran = true; }
+
+    if (!Ran)
+    {
+        fprintf(stderr, "Unknown scenario '%s' (all, spawn, sprint, heightmap, addface, workers, cull, edit, region, directory, stream, raycast, debugdraw, profiler, lod, occlusion)\n", Scenario);
+        return 1;
+    }
+
+    if (FailedChecks)
+    {
+        fprintf(stderr, "%u correctness check%s failed\n", FailedChecks, FailedChecks == 1 ? "" : "s");
+        return 1;
+    }
+    return 0;
+}
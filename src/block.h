@@ -4,6 +4,8 @@
 #include "glm/glm.hpp"
 
 #define TEXTURE_DIMENSION 0.25f // TEXTURE_SIZE / ATLAS_SIZE
+#define ATLAS_TILES 4 // Tiles Per Atlas Row
+#define TEXTURE_REPEAT_STRIDE 256.0f // Encoded TexCoords = Tile * Stride + Repeat, Must Exceed Any Quad Size
 #define BLOCK_RENDER_SIZE 0.50f
 
 enum BlockType
@@ -19,6 +21,16 @@ enum BlockType
     BEDROCK = 8,
 };
 
+enum BlockFace
+{
+    FRONT = 0,  // +Z
+    BACK = 1,   // -Z
+    RIGHT = 2,  // +X
+    LEFT = 3,   // -X
+    TOP = 4,    // +Y
+    BOTTOM = 5, // -Y
+};
+
 typedef struct 
 {
     glm::vec2 Side[4];
@@ -1,53 +1,89 @@
+#include <cstring>
+
 #include "chunk.h"
 #include "chunkmanager.h"
 
-inline u16 GetBlockIndex(const u8 x, const u8 y, const u8 z)
+typedef struct
 {
-    return x + (y * CHUNK_SIZE) + (z * CHUNK_SIZE * CHUNK_HEIGHT);
-}
+    FastNoiseLite Octaves[NOISE_OCTAVES];
+    f32 Amplitudes[NOISE_OCTAVES];
+} TerrainNoise;
 
-void DeleteChunk(Chunk* chunk)
+// Noise State is Built Once and Shared, GetNoise is Const so Any Thread Can Sample It
+static const TerrainNoise& GetTerrainNoise()
 {
-	glDeleteVertexArrays(1, &chunk->VAO);
-	glDeleteBuffers(1, &chunk->VBO);
-	glDeleteBuffers(1, &chunk->EBO);
+    static const TerrainNoise Noise = []
+    {
+        TerrainNoise Result;
+
+        f32 Amplitude = 30.0f;
+        f32 Frequency = 0.003f;
+        for (u8 i = 0; i < NOISE_OCTAVES; i++)
+        {
+            Result.Octaves[i].SetSeed(NOISE_SEED);
+            Result.Octaves[i].SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+            Result.Octaves[i].SetFrequency(Frequency);
+            Result.Amplitudes[i] = Amplitude;
+
+            Amplitude *= 0.5f;
+            Frequency *= 2.0f;
+        }
+        return Result;
+    }();
 
-	delete chunk;
+    return Noise;
 }
 
-inline u8 GetHeightMap(Chunk* chunk, const u8 x, const u8 z)
+void GenerateHeightMap(const Chunk* chunk, u8 HeightMap[CHUNK_SIZE * CHUNK_SIZE])
 {
-    FastNoiseLite noise(NOISE_SEED);
-	noise.SetNoiseType(FastNoiseLite::NoiseType_OpenSimplex2);
+    const TerrainNoise& Noise = GetTerrainNoise();
 
-    f32 Height = 60.0f; // Base Height of Terrain
-    f32 Amplitude = 30.0f;
-    f32 Frequency = 0.003f;
+    // Column Grid Laid Out Flat (Index = x + z * CHUNK_SIZE) so Each Octave is One Tight Loop
+    f32 ColumnX[CHUNK_SIZE * CHUNK_SIZE];
+    f32 ColumnZ[CHUNK_SIZE * CHUNK_SIZE];
+    f32 Heights[CHUNK_SIZE * CHUNK_SIZE];
 
-	// Convert Local Block Position to World Position
-    f32 BlockWorldX = (f32)(chunk->Position.x * CHUNK_SIZE + x);
-    f32 BlockWorldZ = (f32)(chunk->Position.z * CHUNK_SIZE + z);
+	// Convert Local Block Positions to World Positions
+    for (u16 i = 0; i < CHUNK_SIZE * CHUNK_SIZE; ++i)
+    {
+        ColumnX[i] = (f32)(chunk->Position.x * CHUNK_SIZE + (i % CHUNK_SIZE));
+        ColumnZ[i] = (f32)(chunk->Position.z * CHUNK_SIZE + (i / CHUNK_SIZE));
+        Heights[i] = 60.0f; // Base Height of Terrain
+    }
 
-	// Apply Noise Octaves to Height Map
-    for (u8 i = 0; i < NOISE_OCTAVES; i++)
+	// Apply Noise Octaves to Every Column, One Octave at a Time
+    for (u8 Octave = 0; Octave < NOISE_OCTAVES; Octave++)
     {
-		noise.SetFrequency(Frequency);
-		Height += noise.GetNoise(BlockWorldX, BlockWorldZ) * Amplitude;
+        const FastNoiseLite& OctaveNoise = Noise.Octaves[Octave];
+        f32 Amplitude = Noise.Amplitudes[Octave];
 
-        Amplitude *= 0.5f;
-        Frequency *= 2.0f;
+        for (u16 i = 0; i < CHUNK_SIZE * CHUNK_SIZE; ++i)
+        {
+            Heights[i] += OctaveNoise.GetNoise(ColumnX[i], ColumnZ[i]) * Amplitude;
+        }
     }
 
-    return (u8)Height;
+    for (u16 i = 0; i < CHUNK_SIZE * CHUNK_SIZE; ++i)
+    {
+        HeightMap[i] = (u8)Heights[i];
+    }
 }
 
 void GenerateChunk(Chunk* chunk)
 {
+    PROFILE_ZONE("GenerateChunk");
+
+    u8 HeightMap[CHUNK_SIZE * CHUNK_SIZE];
+    GenerateHeightMap(chunk, HeightMap);
+
+    // Terrain is Written Dense Then Packed Into Sections in One Pass
+    u8 Blocks[CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE] = {};
+
     for (u8 x = 0; x < CHUNK_SIZE; ++x)
     {
         for (u8 z = 0; z < CHUNK_SIZE; ++z)
         {
-            u8 Height = GetHeightMap(chunk, x, z);
+            u8 Height = HeightMap[x + z * CHUNK_SIZE];
             for (u8 y = 0; y < Height; ++y)
             {
 				u16 Index = GetBlockIndex(x, y, z);
@@ -55,77 +91,342 @@ void GenerateChunk(Chunk* chunk)
 				{
 					if (y > 80)
 					{
-						chunk->Blocks[Index] = BlockType::SNOW;
+						Blocks[Index] = BlockType::SNOW;
 					}
 					else if (y < WATER_LEVEL)
 					{
-						chunk->Blocks[Index] = BlockType::WATER;
+						Blocks[Index] = BlockType::WATER;
 					}
 					else if (y < 30)
 					{
-						chunk->Blocks[Index] = BlockType::SAND;
+						Blocks[Index] = BlockType::SAND;
 					}
 					else
 					{
-						chunk->Blocks[Index] = BlockType::GRASS;
+						Blocks[Index] = BlockType::GRASS;
 					}
 				}
 				else if (y == 0)
 				{
-					chunk->Blocks[Index] = BlockType::BEDROCK;
+					Blocks[Index] = BlockType::BEDROCK;
 				}
 				else
 				{
-					chunk->Blocks[Index] = BlockType::STONE;
+					Blocks[Index] = BlockType::STONE;
 				}
             }
 
             if (x == 10 && z == 10)
             {
-                if (!(chunk->Blocks[GetBlockIndex(x, Height - 1, z)] == BlockType::SAND || chunk->Blocks[GetBlockIndex(x, Height - 1, z)] == BlockType::WATER))
+                if (!(Blocks[GetBlockIndex(x, Height - 1, z)] == BlockType::SAND || Blocks[GetBlockIndex(x, Height - 1, z)] == BlockType::WATER))
                 {
 					for (u8 i = 0; i < 3; ++i)
 					{
 						for (u8 j = 0; j < 3; ++j)
 						{
 							// Generates Trees
-							chunk->Blocks[GetBlockIndex(x, Height + i + j, z)] = BlockType::WOOD;
-							chunk->Blocks[GetBlockIndex(x + i, Height + 4, z + j)] = BlockType::LEAVES;
-							chunk->Blocks[GetBlockIndex(x + i, Height + 4, z - j)] = BlockType::LEAVES;
-							chunk->Blocks[GetBlockIndex(x - i, Height + 4, z + j)] = BlockType::LEAVES;
-							chunk->Blocks[GetBlockIndex(x - i, Height + 4, z - j)] = BlockType::LEAVES;
-							chunk->Blocks[GetBlockIndex(x + i, Height + 5, z + j)] = BlockType::LEAVES;
-							chunk->Blocks[GetBlockIndex(x + i, Height + 5, z - j)] = BlockType::LEAVES;
-							chunk->Blocks[GetBlockIndex(x - i, Height + 5, z + j)] = BlockType::LEAVES;
-							chunk->Blocks[GetBlockIndex(x - i, Height + 5, z - j)] = BlockType::LEAVES;
-							chunk->Blocks[GetBlockIndex(x + i - 1, Height + 6, z + j - 1)] = BlockType::LEAVES;
-							chunk->Blocks[GetBlockIndex(x + i - 1, Height + 7, z + j - 1)] = BlockType::LEAVES;
+							Blocks[GetBlockIndex(x, Height + i + j, z)] = BlockType::WOOD;
+							Blocks[GetBlockIndex(x + i, Height + 4, z + j)] = BlockType::LEAVES;
+							Blocks[GetBlockIndex(x + i, Height + 4, z - j)] = BlockType::LEAVES;
+							Blocks[GetBlockIndex(x - i, Height + 4, z + j)] = BlockType::LEAVES;
+							Blocks[GetBlockIndex(x - i, Height + 4, z - j)] = BlockType::LEAVES;
+							Blocks[GetBlockIndex(x + i, Height + 5, z + j)] = BlockType::LEAVES;
+							Blocks[GetBlockIndex(x + i, Height + 5, z - j)] = BlockType::LEAVES;
+							Blocks[GetBlockIndex(x - i, Height + 5, z + j)] = BlockType::LEAVES;
+							Blocks[GetBlockIndex(x - i, Height + 5, z - j)] = BlockType::LEAVES;
+							Blocks[GetBlockIndex(x + i - 1, Height + 6, z + j - 1)] = BlockType::LEAVES;
+							Blocks[GetBlockIndex(x + i - 1, Height + 7, z + j - 1)] = BlockType::LEAVES;
 						}
 					}
                 }
             }
         }
     }
+
+    PackChunkBlocks(chunk, Blocks);
+}
+
+void PackChunkBlocks(Chunk* chunk, const u8 Blocks[CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE])
+{
+    u8 SectionBlocks[SECTION_VOLUME];
+    for (u8 Section = 0; Section < SECTION_COUNT; ++Section)
+    {
+        for (u8 z = 0; z < CHUNK_SIZE; ++z)
+        {
+            for (u8 y = 0; y < SECTION_SIZE; ++y)
+            {
+                memcpy(&SectionBlocks[GetSectionIndex(0, y, z)], &Blocks[GetBlockIndex(0, Section * SECTION_SIZE + y, z)], CHUNK_SIZE);
+            }
+        }
+        PackSection(&chunk->Sections[Section], SectionBlocks);
+    }
+}
+
+// Sections are Left as They Were, Generating or Loading the Chunk Rewrites Every One of Them
+Chunk* AcquireChunk()
+{
+    if (Pool.Chunks.empty()) return new Chunk();
+
+    Chunk* chunk = Pool.Chunks.back();
+    Pool.Chunks.pop_back();
+
+    chunk->State = ChunkState::GENERATING;
+    chunk->MeshedNeighbors = 0;
+    chunk->Dirty = false;
+    chunk->MeshRevision = 0;
+    chunk->Lod = 0;
+    chunk->FinerNeighbors = 0;
+    chunk->Slot = 0;
+    chunk->LoadRequest = 0;
+    chunk->GenerateJob = 0;
+    chunk->Position = glm::ivec3(0);
+    for (SectionMesh& Section : chunk->Meshes)
+    {
+        Section = {};
+    }
+    return chunk;
+}
+
+// Index Buffers Go Back to the Shared Spares Right Away, a Pooled Chunk Only Holds its Small Palettes
+void ReleaseChunk(Chunk* chunk)
+{
+    for (BlockSection& Section : chunk->Sections)
+    {
+        ReleaseSectionData(&Section);
+        Section.Bits = 0;
+    }
+
+    if (Pool.Chunks.size() >= CHUNK_POOL_SIZE)
+    {
+        delete chunk;
+        return;
+    }
+    Pool.Chunks.push_back(chunk);
+}
+
+// SnapshotChunk Resets Every Field, Only the Vectors' Capacity Carries Over
+ChunkMesh* AcquireChunkMesh()
+{
+    if (Pool.Meshes.empty()) return new ChunkMesh();
+
+    ChunkMesh* Mesh = Pool.Meshes.back();
+    Pool.Meshes.pop_back();
+    return Mesh;
+}
+
+void ReleaseChunkMesh(ChunkMesh* Mesh)
+{
+    if (Pool.Meshes.size() >= CHUNK_POOL_SIZE)
+    {
+        delete Mesh;
+        return;
+    }
+    Pool.Meshes.push_back(Mesh);
+}
+
+void ClearChunkPool()
+{
+    for (Chunk* chunk : Pool.Chunks) delete chunk;
+    for (ChunkMesh* Mesh : Pool.Meshes) delete Mesh;
+    Pool.Chunks.clear();
+    Pool.Meshes.clear();
+}
+
+// Spares Count Everything They Still Hold, Mesh Vectors Keep Their Largest Capacity Until Freed
+size_t ChunkPoolBytes()
+{
+    size_t Bytes = 0;
+    for (const Chunk* chunk : Pool.Chunks)
+    {
+        Bytes += sizeof(Chunk) + ChunkStorageBytes(chunk);
+    }
+    for (const ChunkMesh* Mesh : Pool.Meshes)
+    {
+        Bytes += sizeof(ChunkMesh) + Mesh->Blocks.capacity() + Mesh->Cells.capacity() + Mesh->Vertices.capacity() * sizeof(ChunkVertex);
+    }
+    return Bytes;
+}
+
+size_t ChunkStorageBytes(const Chunk* chunk)
+{
+    size_t Bytes = 0;
+    for (u8 Section = 0; Section < SECTION_COUNT; ++Section)
+    {
+        Bytes += SectionBytes(&chunk->Sections[Section]);
+    }
+    return Bytes;
+}
+
+// Indexed by BlockFace
+static const glm::vec3 FaceNormals[6] =
+{
+    glm::vec3(0.0f, 0.0f, 1.0f),
+    glm::vec3(0.0f, 0.0f, -1.0f),
+    glm::vec3(1.0f, 0.0f, 0.0f),
+    glm::vec3(-1.0f, 0.0f, 0.0f),
+    glm::vec3(0.0f, 1.0f, 0.0f),
+    glm::vec3(0.0f, -1.0f, 0.0f),
+};
+
+// Meshes Every Section in Mesh->Sections, Other Sections Get Empty Runs
+void GenerateChunkMesh(ChunkMesh* Mesh)
+{
+    PROFILE_ZONE("GenerateChunkMesh");
+
+    if (Mesh->Lod) DownsampleChunk(Mesh);
+
+    for (u8 Section = 0; Section < SECTION_COUNT; ++Section)
+    {
+        Mesh->VertexStart[Section] = (u32)Mesh->Vertices.size();
+
+        if (Mesh->Sections & (1 << Section))
+        {
+            GenerateSectionMesh(Mesh, Section);
+            Mesh->Connectivity[Section] = ComputeSectionConnectivity(Mesh, Section);
+        }
+
+        // Vertical Extent of the Section's Geometry, Tightens its Culling Box
+        Mesh->MinY[Section] = CHUNK_HEIGHT;
+        Mesh->MaxY[Section] = 0;
+        for (u32 i = Mesh->VertexStart[Section]; i < Mesh->Vertices.size(); ++i)
+        {
+#if PACKED_VERTICES
+            u8 Corner = (u8)((Mesh->Vertices[i].Data[0] >> 5) & 255);
+#else
+            u8 Corner = (u8)(Mesh->Vertices[i].Position.y + BLOCK_RENDER_SIZE);
+#endif
+            if (Corner < Mesh->MinY[Section]) Mesh->MinY[Section] = Corner;
+            if (Corner > Mesh->MaxY[Section]) Mesh->MaxY[Section] = Corner;
+        }
+    }
+
+    Mesh->VertexStart[SECTION_COUNT] = (u32)Mesh->Vertices.size();
+}
+
+// True When Every Block Bordering the Section is Solid, the Column's Top & Bottom Count as Open
+static bool SectionEnclosed(const ChunkMesh* Mesh, const u8 Section)
+{
+    const s32 Bottom = Section * SECTION_SIZE - 1;
+    const s32 Top = Section * SECTION_SIZE + SECTION_SIZE;
+    if (Bottom < 0 || Top >= CHUNK_HEIGHT) return false;
+
+    for (s32 a = 0; a < CHUNK_SIZE; ++a)
+    {
+        for (s32 b = 0; b < CHUNK_SIZE; ++b)
+        {
+            if (!Mesh->Blocks[GetPaddedBlockIndex(a, Bottom, b)] || !Mesh->Blocks[GetPaddedBlockIndex(a, Top, b)]) return false;
+        }
+    }
+
+    for (s32 y = Bottom + 1; y < Top; ++y)
+    {
+        for (s32 i = 0; i < CHUNK_SIZE; ++i)
+        {
+            if (!Mesh->Blocks[GetPaddedBlockIndex(-1, y, i)] || !Mesh->Blocks[GetPaddedBlockIndex(CHUNK_SIZE, y, i)]) return false;
+            if (!Mesh->Blocks[GetPaddedBlockIndex(i, y, -1)] || !Mesh->Blocks[GetPaddedBlockIndex(i, y, CHUNK_SIZE)]) return false;
+        }
+    }
+    return true;
+}
+
+// Flood Fills Each Pocket of Air in the Section, Every Pair of Faces One Pocket Touches Can See Each Other
+u16 ComputeSectionConnectivity(const ChunkMesh* Mesh, const u8 Section)
+{
+    const u8 Bit = 1 << Section;
+    if (Mesh->AirSections & Bit) return ALL_FACE_PAIRS;
+    if (Mesh->SolidSections & Bit) return 0;
+
+    // Local Index is x + y * SECTION_SIZE + z * SECTION_SIZE^2, Steps Indexed by BlockFace
+    const s32 Steps[6] = {SECTION_SIZE * SECTION_SIZE, -SECTION_SIZE * SECTION_SIZE, 1, -1, SECTION_SIZE, -SECTION_SIZE};
+    const s32 Bottom = Section * SECTION_SIZE;
+
+    u8 Visited[SECTION_VOLUME] = {};
+    u16 Stack[SECTION_VOLUME];
+    u16 Connectivity = 0;
+
+    for (s32 Start = 0; Start < SECTION_VOLUME; ++Start)
+    {
+        if (Visited[Start]) continue;
+        Visited[Start] = 1;
+        if (Mesh->Blocks[GetPaddedBlockIndex(Start % SECTION_SIZE, Bottom + Start / SECTION_SIZE % SECTION_SIZE, Start / (SECTION_SIZE * SECTION_SIZE))]) continue;
+
+        u8 Faces = 0;
+        u32 Count = 0;
+        Stack[Count++] = (u16)Start;
+        while (Count)
+        {
+            const s32 Index = Stack[--Count];
+            const s32 Local[3] = {Index % SECTION_SIZE, Index / SECTION_SIZE % SECTION_SIZE, Index / (SECTION_SIZE * SECTION_SIZE)};
+
+            // Bit per BlockFace the Block Lies On, Which is Also the Direction That Would Leave the Section
+            u8 Edges = 0;
+            if (Local[2] == SECTION_SIZE - 1) Edges |= 1 << BlockFace::FRONT;
+            if (Local[2] == 0)                Edges |= 1 << BlockFace::BACK;
+            if (Local[0] == SECTION_SIZE - 1) Edges |= 1 << BlockFace::RIGHT;
+            if (Local[0] == 0)                Edges |= 1 << BlockFace::LEFT;
+            if (Local[1] == SECTION_SIZE - 1) Edges |= 1 << BlockFace::TOP;
+            if (Local[1] == 0)                Edges |= 1 << BlockFace::BOTTOM;
+            Faces |= Edges;
+
+            for (u8 Face = 0; Face < 6; ++Face)
+            {
+                if (Edges & (1 << Face)) continue;
+
+                const s32 Next = Index + Steps[Face];
+                if (Visited[Next]) continue;
+                if (Mesh->Blocks[GetPaddedBlockIndex(Next % SECTION_SIZE, Bottom + Next / SECTION_SIZE % SECTION_SIZE, Next / (SECTION_SIZE * SECTION_SIZE))]) continue;
+
+                Visited[Next] = 1;
+                Stack[Count++] = (u16)Next;
+            }
+        }
+
+        for (u8 a = 0; a < 6; ++a)
+        {
+            for (u8 b = a + 1; b < 6; ++b)
+            {
+                if ((Faces >> a & 1) && (Faces >> b & 1)) Connectivity |= 1 << GetFacePairBit(a, b);
+            }
+        }
+        if (Connectivity == ALL_FACE_PAIRS) break;
+    }
+    return Connectivity;
 }
 
-void GenerateChunkMesh(Chunk* chunk)
+void GenerateSectionMesh(ChunkMesh* Mesh, const u8 Section)
 {
+    const u8 Bit = 1 << Section;
+    if (Mesh->AirSections & Bit) return;
+    if ((Mesh->SolidSections & Bit) && SectionEnclosed(Mesh, Section)) return;
+
+    if (Mesh->Lod)
+    {
+        GenerateLodMesh(Mesh, Section);
+        return;
+    }
+
+    if (Mesh->Mode == MeshingMode::GREEDY)
+    {
+        GenerateGreedyMesh(Mesh, Section);
+        return;
+    }
+
     for (u8 x = 0; x < CHUNK_SIZE; ++x)
     {
-		for (u8 y = 0; y < CHUNK_HEIGHT; ++y)
+        for (u8 y = Section * SECTION_SIZE; y < (Section + 1) * SECTION_SIZE; ++y)
         {
-			for (u8 z = 0; z < CHUNK_SIZE; ++z)
+            for (u8 z = 0; z < CHUNK_SIZE; ++z)
             {
-                if (chunk->Blocks[GetBlockIndex(x, y, z)])
+                if (Mesh->Blocks[GetPaddedBlockIndex(x, y, z)])
                 {
-                    GenerateBlockMesh(chunk, x, y, z);
+                    GenerateBlockMesh(Mesh, x, y, z);
                 }
             }
         }
     }
 }
 
-void GenerateBlockMesh(Chunk* chunk, const u8 x, const u8 y, const u8 z)
+void GenerateBlockMesh(ChunkMesh* Mesh, const u8 x, const u8 y, const u8 z)
 {
     glm::vec3 p1(x - BLOCK_RENDER_SIZE, y - BLOCK_RENDER_SIZE, z + BLOCK_RENDER_SIZE);
     glm::vec3 p2(x + BLOCK_RENDER_SIZE, y - BLOCK_RENDER_SIZE, z + BLOCK_RENDER_SIZE);
@@ -137,89 +438,364 @@ void GenerateBlockMesh(Chunk* chunk, const u8 x, const u8 y, const u8 z)
     glm::vec3 p8(x + BLOCK_RENDER_SIZE, y + BLOCK_RENDER_SIZE, z - BLOCK_RENDER_SIZE);
 
 	// Gets Texture of the Block at (x, y, z)
-	u8 TextureIndex = chunk->Blocks[GetBlockIndex(x, y, z)] - 1;
+	u8 TextureIndex = Mesh->Blocks[GetPaddedBlockIndex(x, y, z)] - 1;
 
+	// Side Faces Read Across Chunk Borders Through the Snapshot's Padding
     // Front Face
-    if (z == CHUNK_SIZE - 1 || !chunk->Blocks[GetBlockIndex(x, y, z + 1)])
+    if (!Mesh->Blocks[GetPaddedBlockIndex(x, y, z + 1)])
     {
-		AddFace(chunk, p1, p2, p3, p4, glm::vec3(0.0f, 0.0f, 1.0f), UVTable[TextureIndex].Side);
+		AddFace(Mesh, p1, p2, p3, p4, BlockFace::FRONT, UVTable[TextureIndex].Side);
 	}
 
     // Back Face
-    if (z == 0 || !chunk->Blocks[GetBlockIndex(x, y, z - 1)])
+    if (!Mesh->Blocks[GetPaddedBlockIndex(x, y, z - 1)])
     {
-		AddFace(chunk, p5, p6, p7, p8, glm::vec3(0.0f, 0.0f, -1.0f), UVTable[TextureIndex].Side);
+		AddFace(Mesh, p5, p6, p7, p8, BlockFace::BACK, UVTable[TextureIndex].Side);
 	}
 
     // Right Face
-    if (x == CHUNK_SIZE - 1 || !chunk->Blocks[GetBlockIndex(x + 1, y, z)])
+    if (!Mesh->Blocks[GetPaddedBlockIndex(x + 1, y, z)])
     {
-		AddFace(chunk, p2, p5, p8, p3, glm::vec3(1.0f, 0.0f, 0.0f), UVTable[TextureIndex].Side);
+		AddFace(Mesh, p2, p5, p8, p3, BlockFace::RIGHT, UVTable[TextureIndex].Side);
 	}
 
     // Left Face
-    if (x == 0 || !chunk->Blocks[GetBlockIndex(x - 1, y, z)])
+    if (!Mesh->Blocks[GetPaddedBlockIndex(x - 1, y, z)])
     {
-		AddFace(chunk, p6, p1, p4, p7, glm::vec3(-1.0f, 0.0f, 0.0f), UVTable[TextureIndex].Side);
+		AddFace(Mesh, p6, p1, p4, p7, BlockFace::LEFT, UVTable[TextureIndex].Side);
 	}
 
     // Top Face 
-    if (y == CHUNK_HEIGHT - 1 || !chunk->Blocks[GetBlockIndex(x, y + 1, z)])
+    if (y == CHUNK_HEIGHT - 1 || !Mesh->Blocks[GetPaddedBlockIndex(x, y + 1, z)])
     {
-        AddFace(chunk, p4, p3, p8, p7, glm::vec3(0.0f, 1.0f, 0.0f), UVTable[TextureIndex].Top);
+        AddFace(Mesh, p4, p3, p8, p7, BlockFace::TOP, UVTable[TextureIndex].Top);
     }
 
     // Bottom Face
-    if (y == 0 || !chunk->Blocks[GetBlockIndex(x, y - 1, z)])
+    if (y == 0 || !Mesh->Blocks[GetPaddedBlockIndex(x, y - 1, z)])
+    {
+		AddFace(Mesh, p6, p5, p2, p1, BlockFace::BOTTOM, UVTable[TextureIndex].Bottom);
+    }
+}
+
+// Per-Face Layout for the Greedy Mesher, Indexed by BlockFace
+// Corners Index the Box Points p1..p8 of GenerateBlockMesh so Winding & UVs Match the Naive Mesher
+static const u8 FaceAxis[6] = {2, 2, 0, 0, 1, 1};   // Axis the Face Points Along
+static const s8 FaceSign[6] = {1, -1, 1, -1, 1, -1};
+static const u8 FaceUAxis[6] = {0, 0, 2, 2, 0, 0};  // Axis Along p1 -> p2 (Texture U)
+static const u8 FaceVAxis[6] = {1, 1, 1, 1, 2, 2};  // Axis Along p1 -> p4 (Texture V)
+static const u8 FaceCorners[6][4] =
+{
+    {0, 1, 2, 3}, // Front:  p1, p2, p3, p4
+    {4, 5, 6, 7}, // Back:   p5, p6, p7, p8
+    {1, 4, 7, 2}, // Right:  p2, p5, p8, p3
+    {5, 0, 3, 6}, // Left:   p6, p1, p4, p7
+    {3, 2, 7, 6}, // Top:    p4, p3, p8, p7
+    {5, 4, 1, 0}, // Bottom: p6, p5, p2, p1
+};
+
+// Merges Faces Across One Section of a Padded Grid of Cells, Each Cell Scale Blocks a Side
+// Base Indexes the Section's First Cell, Origin is its Position in Cells & Faces Leaving the Column's ColumnCells are Always Shown
+static void GreedyMeshVolume(ChunkMesh* Mesh, const u8* Cells, const s32 Base, const s32 Dimensions[3], const s32 Strides[3], const s32 Origin[3], const s32 ColumnCells, const s32 Scale)
+{
+    u8 Mask[SECTION_SIZE * SECTION_SIZE];
+
+    for (u8 Face = 0; Face < 6; ++Face)
     {
-		AddFace(chunk, p6, p5, p2, p1, glm::vec3(0.0f, -1.0f, 0.0f), UVTable[TextureIndex].Bottom);
+        const u8 d = FaceAxis[Face];
+        const u8 u = FaceUAxis[Face];
+        const u8 v = FaceVAxis[Face];
+        const s32 SizeU = Dimensions[u];
+        const s32 SizeV = Dimensions[v];
+
+        for (s32 Slice = 0; Slice < Dimensions[d]; ++Slice)
+        {
+            // Mask Holds the Block Type of Every Exposed Face in This Slice, 0 if Hidden
+            // Horizontal Neighbors Always Exist in the Padding, Only the Top & Bottom of the Column Fall Outside
+            s32 Neighbor = Origin[d] + Slice + FaceSign[Face];
+            bool NeighborInside = d != 1 || (Neighbor >= 0 && Neighbor < ColumnCells);
+            s32 NeighborOffset = FaceSign[Face] * Strides[d];
+
+            for (s32 j = 0; j < SizeV; ++j)
+            {
+                s32 RowIndex = Base + Slice * Strides[d] + j * Strides[v];
+                for (s32 i = 0; i < SizeU; ++i)
+                {
+                    s32 Index = RowIndex + i * Strides[u];
+
+                    u8 Block = Cells[Index];
+                    if (Block && NeighborInside && Cells[Index + NeighborOffset])
+                    {
+                        Block = BlockType::AIR;
+                    }
+                    Mask[i + j * SizeU] = Block;
+                }
+            }
+
+            // Grow Each Unvisited Face Along U, Then Along V While the Whole Row Matches
+            for (s32 j = 0; j < SizeV; ++j)
+            {
+                for (s32 i = 0; i < SizeU;)
+                {
+                    u8 Block = Mask[i + j * SizeU];
+                    if (!Block)
+                    {
+                        ++i;
+                        continue;
+                    }
+
+                    s32 Width = 1;
+                    while (i + Width < SizeU && Mask[i + Width + j * SizeU] == Block)
+                    {
+                        Width++;
+                    }
+
+                    s32 Height = 1;
+                    while (j + Height < SizeV)
+                    {
+                        bool RowMatches = true;
+                        for (s32 k = 0; k < Width; ++k)
+                        {
+                            if (Mask[i + k + (j + Height) * SizeU] != Block)
+                            {
+                                RowMatches = false;
+                                break;
+                            }
+                        }
+                        if (!RowMatches) break;
+                        Height++;
+                    }
+
+                    for (s32 h = 0; h < Height; ++h)
+                    {
+                        for (s32 k = 0; k < Width; ++k)
+                        {
+                            Mask[i + k + (j + h) * SizeU] = 0;
+                        }
+                    }
+
+                    // Box Spanning the Merged Cells, Both Sides of the Face Axis so FaceCorners Can Pick Either
+                    glm::vec3 Min(0.0f), Max(0.0f);
+                    Min[d] = (f32)((Origin[d] + Slice) * Scale);
+                    Max[d] = (f32)((Origin[d] + Slice + 1) * Scale);
+                    Min[u] = (f32)((Origin[u] + i) * Scale);
+                    Max[u] = (f32)((Origin[u] + i + Width) * Scale);
+                    Min[v] = (f32)((Origin[v] + j) * Scale);
+                    Max[v] = (f32)((Origin[v] + j + Height) * Scale);
+                    Min -= BLOCK_RENDER_SIZE;
+                    Max -= BLOCK_RENDER_SIZE;
+
+                    const glm::vec3 Corners[8] =
+                    {
+                        glm::vec3(Min.x, Min.y, Max.z),
+                        glm::vec3(Max.x, Min.y, Max.z),
+                        glm::vec3(Max.x, Max.y, Max.z),
+                        glm::vec3(Min.x, Max.y, Max.z),
+                        glm::vec3(Max.x, Min.y, Min.z),
+                        glm::vec3(Min.x, Min.y, Min.z),
+                        glm::vec3(Min.x, Max.y, Min.z),
+                        glm::vec3(Max.x, Max.y, Min.z),
+                    };
+
+                    const TextureUV& Texture = UVTable[Block - 1];
+                    const glm::vec2* UV = Face == BlockFace::TOP ? Texture.Top : Face == BlockFace::BOTTOM ? Texture.Bottom : Texture.Side;
+
+                    const u8* Corner = FaceCorners[Face];
+                    AddFace(Mesh, Corners[Corner[0]], Corners[Corner[1]], Corners[Corner[2]], Corners[Corner[3]], Face, UV, (f32)(Width * Scale), (f32)(Height * Scale));
+
+                    i += Width;
+                }
+            }
+        }
     }
 }
 
-void UpdateChunk(Chunk* chunk) 
+void GenerateGreedyMesh(ChunkMesh* Mesh, const u8 Section)
 {
-	// Clear Buffers in Case of Remesh
-	chunk->Vertices.clear();
-	chunk->Indices.clear();
+    const s32 Dimensions[3] = {CHUNK_SIZE, SECTION_SIZE, CHUNK_SIZE};
+    const s32 Origin[3] = {0, Section * SECTION_SIZE, 0};
+    const s32 Strides[3] = {1, PADDED_CHUNK_SIZE, PADDED_CHUNK_SIZE * CHUNK_HEIGHT}; // Matches GetPaddedBlockIndex
 
-    GenerateChunkMesh(chunk);
+    GreedyMeshVolume(Mesh, Mesh->Blocks.data(), GetPaddedBlockIndex(Origin[0], Origin[1], Origin[2]), Dimensions, Strides, Origin, CHUNK_HEIGHT, 1);
+}
 
-	glGenVertexArrays(1, &chunk->VAO);
-	glBindVertexArray(chunk->VAO);
+// Cells of a Downsampled Column, Padded by One Cell on Each Horizontal Side Like GetPaddedBlockIndex
+static inline u32 GetLodCellIndex(const s32 x, const s32 y, const s32 z, const s32 Size, const s32 Height)
+{
+    return (x + 1) + (y * (Size + 2)) + ((z + 1) * (Size + 2) * Height);
+}
 
-	glGenBuffers(1, &chunk->VBO);
-	glBindBuffer(GL_ARRAY_BUFFER, chunk->VBO);
-	glBufferData(GL_ARRAY_BUFFER, chunk->Vertices.size() * sizeof(Vertex), chunk->Vertices.data(), GL_STATIC_DRAW);
+static const u8 BlockTypeCount = sizeof(UVTable) / sizeof(UVTable[0]) + 1; // Air Plus Every Textured Type
 
-	glGenBuffers(1, &chunk->EBO);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, chunk->EBO);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, chunk->Indices.size() * sizeof(u32), chunk->Indices.data(), GL_STATIC_DRAW);
+// Each Cell Takes the Most Common Type in the Highest Layer of its Blocks Holding Anything, so it's Solid if Any Block is
+// and Coarse Terrain Never Sinks Below the Detail Beside It. Border Cells Only Say Whether the Neighbor Covers That Face:
+// a Finer Neighbor Only Where its Whole Patch is Solid, Otherwise Where Any Block is, Which Always Lands in a Solid Cell
+void DownsampleChunk(ChunkMesh* Mesh)
+{
+    const s32 Scale = 1 << Mesh->Lod;
+    const s32 Size = CHUNK_SIZE / Scale;
+    const s32 Height = CHUNK_HEIGHT / Scale;
+    const s32 SectionCells = SECTION_SIZE / Scale;
+    Mesh->Cells.assign((Size + 2) * Height * (Size + 2), BlockType::AIR);
 
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Position));
-	glEnableVertexAttribArray(0);
+    // Same Sections SnapshotChunk Copied, the Rest Read as Air Either Way
+    const u8 Needed = (Mesh->Sections | (Mesh->Sections << 1) | (Mesh->Sections >> 1)) & ALL_SECTIONS & ~Mesh->AirSections;
 
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
-    glEnableVertexAttribArray(1);
+    u16 Counts[BlockTypeCount];
+    for (u8 Section = 0; Section < SECTION_COUNT; ++Section)
+    {
+        if (!(Needed & (1 << Section))) continue;
 
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
-    glEnableVertexAttribArray(2);
+        for (s32 cy = Section * SectionCells; cy < (Section + 1) * SectionCells; ++cy)
+        {
+            for (s32 cz = 0; cz < Size; ++cz)
+            {
+                for (s32 cx = 0; cx < Size; ++cx)
+                {
+                    u8 Type = BlockType::AIR;
+                    for (s32 y = (cy + 1) * Scale - 1; y >= cy * Scale && !Type; --y)
+                    {
+                        memset(Counts, 0, sizeof(Counts));
+                        for (s32 z = cz * Scale; z < (cz + 1) * Scale; ++z)
+                        {
+                            for (s32 x = cx * Scale; x < (cx + 1) * Scale; ++x)
+                            {
+                                Counts[Mesh->Blocks[GetPaddedBlockIndex(x, y, z)]]++;
+                            }
+                        }
+                        for (u8 Block = 1; Block < BlockTypeCount; ++Block)
+                        {
+                            if (Counts[Block] > (Type ? Counts[Type] : 0)) Type = Block;
+                        }
+                    }
+                    Mesh->Cells[GetLodCellIndex(cx, cy, cz, Size, Height)] = Type;
+                }
+            }
+        }
+
+        // Neighbor Columns Were Only Copied Beside Requested Sections
+        if (!(Mesh->Sections & (1 << Section))) continue;
 
-	glBindVertexArray(0);
+        for (s32 cy = Section * SectionCells; cy < (Section + 1) * SectionCells; ++cy)
+        {
+            for (s32 c = 0; c < Size; ++c)
+            {
+                u16 Solid[4] = {};
+                for (s32 y = cy * Scale; y < (cy + 1) * Scale; ++y)
+                {
+                    for (s32 i = c * Scale; i < (c + 1) * Scale; ++i)
+                    {
+                        Solid[ChunkNeighbor::POSITIVE_X] += Mesh->Blocks[GetPaddedBlockIndex(CHUNK_SIZE, y, i)] != BlockType::AIR;
+                        Solid[ChunkNeighbor::NEGATIVE_X] += Mesh->Blocks[GetPaddedBlockIndex(-1, y, i)] != BlockType::AIR;
+                        Solid[ChunkNeighbor::POSITIVE_Z] += Mesh->Blocks[GetPaddedBlockIndex(i, y, CHUNK_SIZE)] != BlockType::AIR;
+                        Solid[ChunkNeighbor::NEGATIVE_Z] += Mesh->Blocks[GetPaddedBlockIndex(i, y, -1)] != BlockType::AIR;
+                    }
+                }
+
+                u8 Covered[4];
+                for (u8 i = 0; i < 4; ++i)
+                {
+                    Covered[i] = (Mesh->FinerNeighbors & (1 << i)) ? Solid[i] == Scale * Scale : Solid[i] > 0;
+                }
+                Mesh->Cells[GetLodCellIndex(Size, cy, c, Size, Height)] = Covered[ChunkNeighbor::POSITIVE_X];
+                Mesh->Cells[GetLodCellIndex(-1, cy, c, Size, Height)] = Covered[ChunkNeighbor::NEGATIVE_X];
+                Mesh->Cells[GetLodCellIndex(c, cy, Size, Size, Height)] = Covered[ChunkNeighbor::POSITIVE_Z];
+                Mesh->Cells[GetLodCellIndex(c, cy, -1, Size, Height)] = Covered[ChunkNeighbor::NEGATIVE_Z];
+            }
+        }
+    }
+}
+
+// Greedy Meshes the Section From the Cells DownsampleChunk Built, Quads Still Repeat the Texture Once per Block
+void GenerateLodMesh(ChunkMesh* Mesh, const u8 Section)
+{
+    const s32 Scale = 1 << Mesh->Lod;
+    const s32 Size = CHUNK_SIZE / Scale;
+    const s32 Height = CHUNK_HEIGHT / Scale;
+    const s32 Dimensions[3] = {Size, SECTION_SIZE / Scale, Size};
+    const s32 Origin[3] = {0, Section * (SECTION_SIZE / Scale), 0};
+    const s32 Strides[3] = {1, Size + 2, (Size + 2) * Height}; // Matches GetLodCellIndex
+
+    GreedyMeshVolume(Mesh, Mesh->Cells.data(), GetLodCellIndex(Origin[0], Origin[1], Origin[2], Size, Height), Dimensions, Strides, Origin, Height, Scale);
 }
 
-inline void AddFace(Chunk* chunk, glm::vec3& p1, glm::vec3& p2, glm::vec3& p3, glm::vec3& p4, glm::vec3& Normal, const glm::vec2 UV[])
+// Copies the Requested Sections & the Sections Touching Them, Plus the Facing Border Column of Each Loaded Neighbor
+// Missing Neighbors & Sections Not Copied Read as Air
+void SnapshotChunk(const Chunk* chunk, const Chunk* Neighbors[4], ChunkMesh* Mesh, const u8 Sections)
 {
-    size_t Index = chunk->Vertices.size();
+    Mesh->Position = chunk->Position;
+    Mesh->Revision = chunk->MeshRevision;
+    Mesh->Slot = chunk->Slot;
+    Mesh->Sections = Sections;
+    Mesh->AirSections = 0;
+    Mesh->SolidSections = 0;
+    Mesh->Lod = 0;
+    Mesh->FinerNeighbors = 0;
+    Mesh->Blocks.assign(PADDED_CHUNK_SIZE * CHUNK_HEIGHT * PADDED_CHUNK_SIZE, BlockType::AIR);
+    Mesh->Vertices.clear();
+
+    const u8 Needed = (Sections | (Sections << 1) | (Sections >> 1)) & ALL_SECTIONS;
+
+    // Uniform Air Sections Stay as the Fill Above, Others are Unpacked Row by Row
+    u8 SectionBlocks[SECTION_VOLUME];
+    for (u8 Section = 0; Section < SECTION_COUNT; ++Section)
+    {
+        const BlockSection* Source = &chunk->Sections[Section];
+        if (!Source->Bits)
+        {
+            Source->Value == BlockType::AIR ? Mesh->AirSections |= 1 << Section : Mesh->SolidSections |= 1 << Section;
+        }
+        if (!(Needed & (1 << Section)) || (Mesh->AirSections & (1 << Section))) continue;
+
+        UnpackSection(Source, SectionBlocks);
+        for (u8 z = 0; z < CHUNK_SIZE; ++z)
+        {
+            for (u8 y = 0; y < SECTION_SIZE; ++y)
+            {
+                memcpy(&Mesh->Blocks[GetPaddedBlockIndex(0, Section * SECTION_SIZE + y, z)], &SectionBlocks[GetSectionIndex(0, y, z)], CHUNK_SIZE);
+            }
+        }
 
-	chunk->Vertices.push_back({UV[0], p1, Normal});
-	chunk->Vertices.push_back({UV[1], p2, Normal});
-	chunk->Vertices.push_back({UV[2], p3, Normal});
-	chunk->Vertices.push_back({UV[3], p4, Normal});
+        // Only the Requested Sections Read the Neighbor Columns Beside Them
+        if (!(Sections & (1 << Section))) continue;
 
-	chunk->Indices.push_back((u32)Index + 0);
-	chunk->Indices.push_back((u32)Index + 1);
-	chunk->Indices.push_back((u32)Index + 2);
-	chunk->Indices.push_back((u32)Index + 0);
-	chunk->Indices.push_back((u32)Index + 2);
-	chunk->Indices.push_back((u32)Index + 3);
+        for (u8 y = Section * SECTION_SIZE; y < (Section + 1) * SECTION_SIZE; ++y)
+        {
+            for (u8 i = 0; i < CHUNK_SIZE; ++i)
+            {
+                if (Neighbors[ChunkNeighbor::POSITIVE_X]) Mesh->Blocks[GetPaddedBlockIndex(CHUNK_SIZE, y, i)] = GetChunkBlock(Neighbors[ChunkNeighbor::POSITIVE_X], 0, y, i);
+                if (Neighbors[ChunkNeighbor::NEGATIVE_X]) Mesh->Blocks[GetPaddedBlockIndex(-1, y, i)] = GetChunkBlock(Neighbors[ChunkNeighbor::NEGATIVE_X], CHUNK_SIZE - 1, y, i);
+                if (Neighbors[ChunkNeighbor::POSITIVE_Z]) Mesh->Blocks[GetPaddedBlockIndex(i, y, CHUNK_SIZE)] = GetChunkBlock(Neighbors[ChunkNeighbor::POSITIVE_Z], i, y, 0);
+                if (Neighbors[ChunkNeighbor::NEGATIVE_Z]) Mesh->Blocks[GetPaddedBlockIndex(i, y, -1)] = GetChunkBlock(Neighbors[ChunkNeighbor::NEGATIVE_Z], i, y, CHUNK_SIZE - 1);
+            }
+        }
+    }
+}
+
+void AddFace(ChunkMesh* Mesh, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3, const glm::vec3& p4, const u8 Face, const glm::vec2 UV[], const f32 Width, const f32 Height)
+{
+	// TexCoords Hold the Atlas Tile and How Many Times it Repeats Across the Quad, fragment.glsl Wraps Them Per Block
+	glm::vec2 TileMin = glm::min(glm::min(UV[0], UV[1]), glm::min(UV[2], UV[3]));
+	glm::vec2 Repeat(Width / TEXTURE_DIMENSION, Height / TEXTURE_DIMENSION);
+
+#if PACKED_VERTICES
+	glm::uvec2 Tile = glm::uvec2(TileMin / TEXTURE_DIMENSION);
+	u8 TileIndex = (u8)(Tile.x + Tile.y * ATLAS_TILES);
+
+	Mesh->Vertices.push_back(PackVertex(p1, Face, TileIndex, (UV[0] - TileMin) * Repeat, Mesh->Slot));
+	Mesh->Vertices.push_back(PackVertex(p2, Face, TileIndex, (UV[1] - TileMin) * Repeat, Mesh->Slot));
+	Mesh->Vertices.push_back(PackVertex(p3, Face, TileIndex, (UV[2] - TileMin) * Repeat, Mesh->Slot));
+	Mesh->Vertices.push_back(PackVertex(p4, Face, TileIndex, (UV[3] - TileMin) * Repeat, Mesh->Slot));
+#else
+	glm::vec2 Tile = TileMin / TEXTURE_DIMENSION * TEXTURE_REPEAT_STRIDE;
+	const glm::vec3& Normal = FaceNormals[Face];
+
+	// Float Vertices Have No Room for a Slot, so They're Stored in World Space Instead
+	glm::vec3 Origin(Mesh->Position.x * CHUNK_SIZE, Mesh->Position.y * CHUNK_HEIGHT, Mesh->Position.z * CHUNK_SIZE);
+
+	Mesh->Vertices.push_back({Tile + (UV[0] - TileMin) * Repeat, Origin + p1, Normal});
+	Mesh->Vertices.push_back({Tile + (UV[1] - TileMin) * Repeat, Origin + p2, Normal});
+	Mesh->Vertices.push_back({Tile + (UV[2] - TileMin) * Repeat, Origin + p3, Normal});
+	Mesh->Vertices.push_back({Tile + (UV[3] - TileMin) * Repeat, Origin + p4, Normal});
+#endif
 }
\ No newline at end of file
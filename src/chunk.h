@@ -1,6 +1,7 @@
 #ifndef __CHUNK_H__
 #define __CHUNK_H__
 
+#include <utility>
 #include <vector>
 
 #include "FastNoiseLite.h"
@@ -9,11 +10,31 @@
 #include "glm/glm.hpp"
 #include "utils/common.h"
 #include "utils/shader.h"
+#include "utils/bufferarena.h"
+#include "utils/profiler.h"
 #include "block.h"
+#include "section.h"
 
 #define CHUNK_SIZE 16
 #define CHUNK_HEIGHT 128
 #define WATER_LEVEL 27
+#define SECTION_COUNT (CHUNK_HEIGHT / SECTION_SIZE) // At Most 8, Section Sets are Passed Around as u8 Bit Masks
+#define ALL_SECTIONS ((u8)((1u << SECTION_COUNT) - 1))
+
+#define PADDED_CHUNK_SIZE (CHUNK_SIZE + 2) // Mesh Snapshots Carry a One Block Border From Each Neighbor
+#define ALL_FACE_PAIRS ((u16)0x7FFF) // Connectivity of a Section With Nothing in the Way, One Bit per Pair of the 6 Faces
+#define LOD_COUNT 4 // Level L Meshes Cells 1 << L Blocks a Side, Every Level's Cells Divide a Section Evenly
+
+// 8 Byte Packed Chunk Vertices, Build With PACKED_VERTICES=0 for the 32 Byte Float Layout
+#ifndef PACKED_VERTICES
+#define PACKED_VERTICES 1
+#endif
+
+#if PACKED_VERTICES
+#define CHUNK_SHADER_DEFINES "#define PACKED_VERTICES\n"
+#else
+#define CHUNK_SHADER_DEFINES ""
+#endif
 
 #define NOISE_OCTAVES 4
 #define NOISE_SEED 999
@@ -25,22 +46,161 @@ typedef struct
     glm::vec3 Normal;
 } Vertex;
 
+// Data[0]: Corner X (5 Bits) | Corner Y (8) | Corner Z (5) | BlockFace (3) | Atlas Tile (4)
+// Data[1]: Texture Repeat U (8 Bits) | Texture Repeat V (8) | Chunk Slot (16)
+// Corners Sit on Block Edges, Position = Corner - BLOCK_RENDER_SIZE + Origin of the Slot's Chunk
+typedef struct
+{
+    u32 Data[2];
+} PackedVertex;
+
+#if PACKED_VERTICES
+typedef PackedVertex ChunkVertex;
+#else
+typedef Vertex ChunkVertex;
+#endif
+
+enum ChunkState
+{
+    GENERATING = 0, // Queued or Running on a Worker, Blocks Not Safe to Read
+    GENERATED = 1,  // Blocks Ready, Owned by the Main Thread
+    UNLOADED = 2,   // Left Range While Generating, Deleted Once the Worker Hands it Back
+};
+
+enum MeshingMode
+{
+    NAIVE = 0,  // One Quad per Exposed Block Face
+    GREEDY = 1, // Coplanar Faces of the Same Block Merged into Maximal Rectangles
+};
+
+// Order of the Horizontal Neighbors Passed to SnapshotChunk & Bits of Chunk::MeshedNeighbors
+enum ChunkNeighbor
+{
+    POSITIVE_X = 0,
+    NEGATIVE_X = 1,
+    POSITIVE_Z = 2,
+    NEGATIVE_Z = 3,
+};
+
+// One Section's Slice of the Uploaded Mesh, Drawn & Culled on its Own
+typedef struct
+{
+    u32 Revision; // Newest Mesh Requested for This Section, Older Ones are Dropped
+    u32 Uploaded; // Revision Currently in the Buffers, Behind Revision While a Remesh is in Flight
+    ArenaRange VertexRange; // Location in the Shared Vertex Buffer, Empty When Unmeshed or Hidden
+    u32 IndexCount; // 6 per Quad, Every Section Draws From the Shared Quad Index Buffer
+    u8 MinY, MaxY; // Lowest & Highest Vertex Corner Heights
+    u16 Connectivity; // Face Pairs Joined Through Air Inside the Section (GetFacePairBit), Valid Once Uploaded is Set
+    u8 EnteredFaces; // Faces the Occlusion Walk Has Come in Through, Only Meaningful When VisibleFrame is Current
+    u32 VisibleFrame; // Last Frame the Occlusion Walk Reached This Section
+} SectionMesh;
+
 typedef struct
 {
-    u32 VAO, VBO, EBO;
+    u8 State;
+    u8 MeshedNeighbors; // Bit per ChunkNeighbor That Was Loaded When the Current Mesh Was Requested
+    bool Dirty; // Edited Since it Was Generated or Loaded, Saved to its Region When Unloaded
+    u32 MeshRevision; // Newest Revision Requested for Any Section, 0 Until First Meshed
+    u8 Lod; // Detail Level of the Newest Mesh Requested
+    u8 FinerNeighbors; // Bit per ChunkNeighbor Wanted at a Finer Level Than Lod When That Mesh Was Requested
+    u16 Slot; // Index Into the Chunk Origin Table Read by vertex.glsl
+    u64 RequestedAt; // ProfileNow() When CreateChunk Requested it, 0 Once its First Mesh is Uploaded
+    u64 LoadRequest; // RegionStore Ticket for Reading it Back, What CancelLoad Takes
+    u64 GenerateJob; // WorkerPool Id Reserved for Generating it, the Only Job Whose Cancellation Means No Thread Holds it
     glm::ivec3 Position;
-    std::vector<u32> Indices;
-    std::vector<Vertex> Vertices;
-    std::vector<u8> Blocks;
+    SectionMesh Meshes[SECTION_COUNT];
+    BlockSection Sections[SECTION_COUNT]; // Bottom to Top, Read Through GetChunkBlock
 } Chunk;
 
-void UpdateChunk(Chunk* chunk);
-void DeleteChunk(Chunk* chunk);
+// Self-Contained Meshing Job, Built on a Worker From a Snapshot of the Chunk's Blocks
+// Output of Each Requested Section is a Contiguous Run of Quads, 4 Vertices Each in 0, 1, 2 / 0, 2, 3 Order
+typedef struct
+{
+    glm::ivec3 Position;
+    u32 Revision;
+    u16 Slot;
+    u8 Mode;
+    u8 Sections; // Bit per Section to Mesh
+    u8 AirSections; // Uniform Air, Skipped Outright
+    u8 SolidSections; // Uniform Solid, Skipped When Every Block Around Them is Solid Too
+    u8 Lod; // Above 0 the Sections are Meshed From Cells Downsampled by 1 << Lod
+    u8 FinerNeighbors; // Bit per ChunkNeighbor at a Finer Level, Borders Facing Them are Only Culled Where Fully Covered
+    u8 MinY[SECTION_COUNT], MaxY[SECTION_COUNT];
+    u32 VertexStart[SECTION_COUNT + 1];
+    u16 Connectivity[SECTION_COUNT];
+    std::vector<u8> Blocks; // PADDED_CHUNK_SIZE x CHUNK_HEIGHT x PADDED_CHUNK_SIZE, Index With GetPaddedBlockIndex
+    std::vector<u8> Cells; // Downsampled Blocks Plus Neighbor Coverage When Lod is Above 0
+    std::vector<ChunkVertex> Vertices;
+} ChunkMesh;
+
+#define CHUNK_POOL_SIZE 1024 // Spare Chunks & Mesh Jobs Kept for Reuse, Any Beyond This are Freed
+
+// Recycled Chunks & Mesh Jobs, Block Sections & Mesh Vectors Keep Their Capacity Between Uses
+// so Steady Streaming Stops Allocating Once the Spares Have Grown to Fit. Main Thread Only
+typedef struct
+{
+    std::vector<Chunk*> Chunks;
+    std::vector<ChunkMesh*> Meshes;
+} ChunkPool;
+
+inline ChunkPool Pool;
+
+Chunk* AcquireChunk();
+void ReleaseChunk(Chunk* chunk);
+ChunkMesh* AcquireChunkMesh();
+void ReleaseChunkMesh(ChunkMesh* Mesh);
+void ClearChunkPool();
+size_t ChunkPoolBytes();
+
 void GenerateChunk(Chunk* chunk);
-void GenerateChunkMesh(Chunk* chunk);
-void GenerateBlockMesh(Chunk* chunk, const u8 x, const u8 y, const u8 z);
-inline void AddFace(Chunk* chunk, glm::vec3& p1, glm::vec3& p2, glm::vec3& p3, glm::vec3& p4, glm::vec3& normal, const glm::vec2 uv[]);
-inline u8 GetHeightMap(Chunk* chunk, const u8 x, const u8 z);
-inline u16 GetBlockIndex(const u8 x, const u8 y, const u8 z);
+void SnapshotChunk(const Chunk* chunk, const Chunk* Neighbors[4], ChunkMesh* Mesh, const u8 Sections = ALL_SECTIONS);
+void GenerateChunkMesh(ChunkMesh* Mesh);
+void GenerateSectionMesh(ChunkMesh* Mesh, const u8 Section);
+void GenerateGreedyMesh(ChunkMesh* Mesh, const u8 Section);
+u16 ComputeSectionConnectivity(const ChunkMesh* Mesh, const u8 Section);
+void DownsampleChunk(ChunkMesh* Mesh);
+void GenerateLodMesh(ChunkMesh* Mesh, const u8 Section);
+void GenerateBlockMesh(ChunkMesh* Mesh, const u8 x, const u8 y, const u8 z);
+void AddFace(ChunkMesh* Mesh, const glm::vec3& p1, const glm::vec3& p2, const glm::vec3& p3, const glm::vec3& p4, const u8 Face, const glm::vec2 uv[], const f32 Width = 1.0f, const f32 Height = 1.0f);
+void GenerateHeightMap(const Chunk* chunk, u8 HeightMap[CHUNK_SIZE * CHUNK_SIZE]);
+void PackChunkBlocks(Chunk* chunk, const u8 Blocks[CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE]);
+size_t ChunkStorageBytes(const Chunk* chunk);
+
+inline u16 GetBlockIndex(const u8 x, const u8 y, const u8 z)
+{
+    return x + (y * CHUNK_SIZE) + (z * CHUNK_SIZE * CHUNK_HEIGHT);
+}
+
+inline u8 GetChunkBlock(const Chunk* chunk, const u8 x, const u8 y, const u8 z)
+{
+    return GetSectionBlock(&chunk->Sections[y / SECTION_SIZE], GetSectionIndex(x, y % SECTION_SIZE, z));
+}
+
+inline void SetChunkBlock(Chunk* chunk, const u8 x, const u8 y, const u8 z, const u8 Type)
+{
+    SetSectionBlock(&chunk->Sections[y / SECTION_SIZE], GetSectionIndex(x, y % SECTION_SIZE, z), Type);
+}
+
+inline PackedVertex PackVertex(const glm::vec3& Position, const u8 Face, const u8 Tile, const glm::vec2& Repeat, const u16 Slot)
+{
+    u32 x = (u32)(Position.x + BLOCK_RENDER_SIZE);
+    u32 y = (u32)(Position.y + BLOCK_RENDER_SIZE);
+    u32 z = (u32)(Position.z + BLOCK_RENDER_SIZE);
+
+    return {{x | (y << 5) | (z << 13) | ((u32)Face << 18) | ((u32)Tile << 21), (u32)Repeat.x | ((u32)Repeat.y << 8) | ((u32)Slot << 16)}};
+}
+
+// Bit Within SectionMesh::Connectivity for Two Different BlockFaces, in Either Order
+inline u8 GetFacePairBit(u8 a, u8 b)
+{
+    if (a > b) std::swap(a, b);
+    return (u8)(a * (11 - a) / 2 + b - a - 1);
+}
+
+// Local Block Position in a Padded Snapshot, x & z May Range From -1 to CHUNK_SIZE
+inline u32 GetPaddedBlockIndex(const s32 x, const s32 y, const s32 z)
+{
+    return (x + 1) + (y * PADDED_CHUNK_SIZE) + ((z + 1) * PADDED_CHUNK_SIZE * CHUNK_HEIGHT);
+}
 
 #endif
\ No newline at end of file
@@ -0,0 +1,80 @@
+#ifndef __CHUNKGRID_H__
+#define __CHUNKGRID_H__
+
+#include <algorithm>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "utils/common.h"
+#include "chunk.h"
+
+// Loaded Chunks in a Square of Cells Indexed by Chunk Coordinate Modulo the Side, so the Square Wraps
+// Around the Player Instead of Moving. Loaded Chunks All Lie Within the Radius it Was Sized For,
+// Which Means Two of Them Never Land in the Same Cell as Long as Leaving Chunks are Erased First
+struct ChunkGrid
+{
+    // Side is Rounded Up to a Power of Two so a Cell Index is Two Masks, Chunks Already Held Carry Over
+    void Resize(s32 Radius)
+    {
+        std::vector<Chunk*> Previous;
+        Previous.swap(Cells);
+
+        Side = 1;
+        while (Side < 2 * Radius + 1) Side <<= 1;
+        Mask = Side - 1;
+        Cells.assign((size_t)Side * Side, nullptr);
+        Count = 0;
+
+        for (Chunk* chunk : Previous)
+        {
+            if (chunk) Insert(chunk);
+        }
+    }
+
+    inline u32 GetCellIndex(glm::ivec3 Position) const
+    {
+        return (u32)(Position.x & Mask) + (u32)(Position.z & Mask) * (u32)Side;
+    }
+
+    inline Chunk* Find(glm::ivec3 Position) const
+    {
+        Chunk* chunk = Cells[GetCellIndex(Position)];
+        return chunk && chunk->Position == Position ? chunk : nullptr;
+    }
+
+    // Returns False if Another Chunk Still Holds the Cell
+    inline bool Insert(Chunk* chunk)
+    {
+        Chunk*& Cell = Cells[GetCellIndex(chunk->Position)];
+        if (Cell && Cell != chunk) return false;
+
+        if (!Cell) Count++;
+        Cell = chunk;
+        return true;
+    }
+
+    inline void Erase(glm::ivec3 Position)
+    {
+        Chunk*& Cell = Cells[GetCellIndex(Position)];
+        if (Cell && Cell->Position == Position)
+        {
+            Cell = nullptr;
+            Count--;
+        }
+    }
+
+    void Clear()
+    {
+        std::fill(Cells.begin(), Cells.end(), nullptr);
+        Count = 0;
+    }
+
+    size_t Size() const { return Count; }
+
+    std::vector<Chunk*> Cells; // Row Major, Neighbors in X are Adjacent, Empty Cells are Null
+    s32 Side = 0;
+    s32 Mask = 0;
+    size_t Count = 0;
+};
+
+#endif
@@ -1,133 +1,992 @@
+#include <algorithm>
+#include <chrono>
+
 #include "chunkmanager.h"
 
+// Chunk Offsets Indexed by ChunkNeighbor, Opposite Direction is Neighbor ^ 1
+static const glm::ivec3 NeighborOffsets[4] =
+{
+	glm::ivec3(1, 0, 0),
+	glm::ivec3(-1, 0, 0),
+	glm::ivec3(0, 0, 1),
+	glm::ivec3(0, 0, -1),
+};
+
+void InitWorld(const char* WorldDirectory)
+{
+    Manager.VertexArena.Create(sizeof(ChunkVertex), VERTEX_ARENA_CAPACITY, VERTEX_ARENA_MAX_CAPACITY);
+
+    // 0, 1, 2 / 0, 2, 3 per Quad, Base Vertex Moves Each Draw Onto its Section's Vertices
+    std::vector<u16> QuadIndices(QUADS_PER_DRAW * 6);
+    for (u32 Quad = 0; Quad < QUADS_PER_DRAW; ++Quad)
+    {
+        const u16 Corner = (u16)(Quad * 4);
+        const u16 Pattern[6] = {0, 1, 2, 0, 2, 3};
+        for (u8 i = 0; i < 6; ++i) QuadIndices[Quad * 6 + i] = Corner + Pattern[i];
+    }
+    glGenBuffers(1, &Manager.QuadIndexBuffer);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, Manager.QuadIndexBuffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, QuadIndices.size() * sizeof(u16), QuadIndices.data(), GL_STATIC_DRAW);
+
+    glGenVertexArrays(1, &Manager.VAO);
+    BindMeshArenas();
+
+    // Chunk World Origins (Block Units) as ivec2 X/Z, Fetched per Vertex by Slot
+    glGenBuffers(1, &Manager.OriginBuffer);
+    glBindBuffer(GL_TEXTURE_BUFFER, Manager.OriginBuffer);
+    glBufferData(GL_TEXTURE_BUFFER, MAX_CHUNK_SLOTS * sizeof(glm::ivec2), nullptr, GL_DYNAMIC_DRAW);
+    glGenTextures(1, &Manager.OriginTexture);
+    glBindTexture(GL_TEXTURE_BUFFER, Manager.OriginTexture);
+    glTexBuffer(GL_TEXTURE_BUFFER, GL_RG32I, Manager.OriginBuffer);
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    ClampSettings(&Config);
+    Manager.RenderDistance = Config.RenderDistance;
+    Manager.UploadBudgetUs = Config.UploadBudgetUs;
+    Manager.OcclusionCulling = true;
+    Manager.OcclusionFrame = 0;
+
+    Manager.Chunks.Resize(MAX_RENDER_DISTANCE + UNLOAD_MARGIN);
+    Manager.Retained.reserve(MAX_RETAINED_CHUNKS + 1);
+    Manager.Workers.Start(Config.WorkerCount ? Config.WorkerCount : WorkerPool::DefaultWorkerCount());
+    Manager.Regions.Start(WorldDirectory);
+}
+
+void ShutdownWorld()
+{
+    // Stop Workers First so No Chunk is Still Being Written To
+    Manager.Workers.Stop();
+
+    // Every Edited Chunk Still Loaded or Retained is Saved, Stop Waits for the Writes to Finish
+    for (Chunk* chunk : Manager.Chunks.Cells)
+    {
+        if (chunk && chunk->State == ChunkState::GENERATED && chunk->Dirty)
+        {
+            Manager.Regions.Save(chunk);
+        }
+    }
+    for (Chunk* chunk : Manager.RetainedOrder)
+    {
+        if (chunk->Dirty) Manager.Regions.Save(chunk);
+        DeleteChunk(chunk);
+    }
+    Manager.RetainedOrder.clear();
+    Manager.Retained.clear();
+    Manager.RetainedBytes = 0;
+    Manager.SpareOrderNodes.clear();
+    Manager.SpareRetainedNodes.clear();
+    Manager.Regions.Stop();
+
+    for (Chunk* chunk : Manager.Generated)
+    {
+        if (chunk->State == ChunkState::UNLOADED)
+        {
+            DeleteChunk(chunk);
+        }
+    }
+    Manager.Generated.clear();
+
+    for (ChunkMesh* Mesh : Manager.Meshed)
+    {
+        ReleaseChunkMesh(Mesh);
+    }
+    for (ChunkMesh* Mesh : Manager.Uploading)
+    {
+        ReleaseChunkMesh(Mesh);
+    }
+    Manager.Meshed.clear();
+    Manager.Uploading.clear();
+
+    for (Chunk* chunk : Manager.Chunks.Cells)
+    {
+        if (chunk) DeleteChunk(chunk);
+    }
+    Manager.Chunks.Clear();
+    Manager.Streamed = false;
+    ClearChunkPool();
+
+    glDeleteTextures(1, &Manager.OriginTexture);
+    glDeleteBuffers(1, &Manager.OriginBuffer);
+    glDeleteVertexArrays(1, &Manager.VAO);
+    Manager.VertexArena.Destroy();
+    glDeleteBuffers(1, &Manager.QuadIndexBuffer);
+}
+
+// Returns the Chunk's Mesh Ranges and Slot Before Freeing It
+void DeleteChunk(Chunk* chunk)
+{
+    for (SectionMesh& Section : chunk->Meshes)
+    {
+        Manager.VertexArena.Free(&Section.VertexRange);
+    }
+    Manager.FreeSlots.push_back(chunk->Slot);
+
+    ReleaseChunk(chunk);
+}
+
+// Returns the Chunk at Position Only Once its Blocks are Safe to Read
+Chunk* GetChunk(glm::ivec3 Position)
+{
+    Chunk* chunk = Manager.Chunks.Find(Position);
+    if (!chunk || chunk->State != ChunkState::GENERATED)
+    {
+        return nullptr;
+    }
+    return chunk;
+}
+
 void SetBlock(Chunk* chunk, glm::ivec3 BlockPosition, u8 CurrentHeldBlock, bool PlaceMode)
 {
-    u16 Index = GetBlockIndex(BlockPosition.x, BlockPosition.y, BlockPosition.z);
-    
-	// Either Places or Breaks Block, Then Updates the Chunk Mesh
-	PlaceMode ? chunk->Blocks[Index] = CurrentHeldBlock : chunk->Blocks[Index] = BlockType::AIR;
-	UpdateChunk(chunk);
+	// Either Places or Breaks Block, Then Remeshes its Section (Old Mesh Stays Visible Until the New One Uploads)
+	SetChunkBlock(chunk, BlockPosition.x, BlockPosition.y, BlockPosition.z, PlaceMode ? CurrentHeldBlock : (u8)BlockType::AIR);
+	chunk->Dirty = true;
+
+	// Edits on a Section's Top or Bottom Layer Also Change What the Section Beside it Culls Against
+	u8 Section = BlockPosition.y / SECTION_SIZE;
+	u8 Sections = 1 << Section;
+	if (BlockPosition.y % SECTION_SIZE == 0 && Section > 0)                            Sections |= 1 << (Section - 1);
+	if (BlockPosition.y % SECTION_SIZE == SECTION_SIZE - 1 && Section < SECTION_COUNT - 1) Sections |= 1 << (Section + 1);
+	QueueChunkMesh(chunk, Sections);
+
+	// Border Edits Change What the Adjacent Chunk Culls Against, Only at the Edited Height
+	if (BlockPosition.x == CHUNK_SIZE - 1) RemeshNeighbor(chunk, ChunkNeighbor::POSITIVE_X, 1 << Section);
+	if (BlockPosition.x == 0)              RemeshNeighbor(chunk, ChunkNeighbor::NEGATIVE_X, 1 << Section);
+	if (BlockPosition.z == CHUNK_SIZE - 1) RemeshNeighbor(chunk, ChunkNeighbor::POSITIVE_Z, 1 << Section);
+	if (BlockPosition.z == 0)              RemeshNeighbor(chunk, ChunkNeighbor::NEGATIVE_Z, 1 << Section);
+}
+
+void QueueChunkMesh(Chunk* chunk, u8 Sections)
+{
+	// A Level Change Remeshes Everything, Sections Left at the Old Level Would Leave Cracks Between Them
+	const u8 Lod = ChunkLod(chunk->Position);
+	const u8 Finer = FinerNeighbors(chunk->Position, Lod);
+	if (Lod != chunk->Lod || Finer != chunk->FinerNeighbors) Sections = ALL_SECTIONS;
+	chunk->Lod = Lod;
+	chunk->FinerNeighbors = Finer;
+
+	chunk->MeshRevision = ++Manager.MeshRevision;
+	for (u8 Section = 0; Section < SECTION_COUNT; ++Section)
+	{
+		if (Sections & (1 << Section)) chunk->Meshes[Section].Revision = chunk->MeshRevision;
+	}
+
+	// Only a Full Remesh Picks Up Every Border, Partial Ones Leave the Record Alone
+	const Chunk* Neighbors[4];
+	if (Sections == ALL_SECTIONS) chunk->MeshedNeighbors = 0;
+	for (u8 i = 0; i < 4; ++i)
+	{
+		Neighbors[i] = GetChunk(chunk->Position + NeighborOffsets[i]);
+		if (Neighbors[i] && Sections == ALL_SECTIONS) chunk->MeshedNeighbors |= 1 << i;
+	}
+
+	ChunkMesh* Mesh = AcquireChunkMesh();
+	SnapshotChunk(chunk, Neighbors, Mesh, Sections);
+	Mesh->Mode = Manager.Mesher;
+	Mesh->Lod = Lod;
+	Mesh->FinerNeighbors = Finer;
+
+	// A Remesh Rarely Differs Much From the Mesh it Replaces, Reserving That Avoids Growing Mid-Mesh
+	u32 VertexCount = 0;
+	for (u8 Section = 0; Section < SECTION_COUNT; ++Section)
+	{
+		if (Sections & (1 << Section)) VertexCount += chunk->Meshes[Section].VertexRange.Count;
+	}
+	Mesh->Vertices.reserve(VertexCount);
+
+	Manager.Workers.Submit(chunk->Position, [Mesh]
+	{
+		GenerateChunkMesh(Mesh);
+		PROFILE_COUNT(CHUNKS_MESHED, 1);
+
+		std::lock_guard<std::mutex> Lock(Manager.MeshedMutex);
+		Manager.Meshed.push_back(Mesh);
+	},
+	[Mesh]
+	{
+		ReleaseChunkMesh(Mesh);
+	});
+}
+
+// Switches Mesher at Runtime and Remeshes Everything Loaded so Both Can be Compared Live
+void SetMeshingMode(u8 Mode)
+{
+	Manager.Mesher = Mode;
+
+	for (Chunk* chunk : Manager.Chunks.Cells)
+	{
+		if (chunk && chunk->State == ChunkState::GENERATED && chunk->MeshRevision)
+		{
+			QueueChunkMesh(chunk);
+		}
+	}
+}
+
+// Brings the Running World in Line With Config After it Changes, Loaded Chunks Stay Put
+void ApplySettings()
+{
+	ClampSettings(&Config);
+	Manager.Workers.Resize(Config.WorkerCount ? Config.WorkerCount : WorkerPool::DefaultWorkerCount());
+	Manager.UploadBudgetUs = Config.UploadBudgetUs;
+	Manager.CalmIntervals = 0;
+	SetRenderDistance(Config.RenderDistance);
+}
+
+// Streams Only the Difference: Growing Loads the New Rings Nearest First, Shrinking Unloads Past the New Unload Distance
+void SetRenderDistance(s32 Distance)
+{
+	Distance = std::clamp(Distance, MIN_RENDER_DISTANCE, MAX_RENDER_DISTANCE);
+	if (Distance == Manager.RenderDistance) return;
+
+	s32 Previous = Manager.RenderDistance;
+	Manager.RenderDistance = Distance;
+	if (!Manager.Streamed) return;
+
+	if (Distance < Previous)
+	{
+		UnloadChunks(Manager.StreamedChunk.x, Manager.StreamedChunk.z);
+	}
+	else
+	{
+		LoadChunks(Manager.StreamedChunk.x, Manager.StreamedChunk.z, Previous + 1);
+	}
+}
+
+// Loaded & Retained Chunks Counted the Way the Retention Budget Counts Them, Blocks Plus Their Mesh Vertices,
+// Then Everything Held for Reuse: Pooled Chunks & Mesh Jobs, Spare Index Buffers & the Arena's Unused Vertex Space
+size_t WorldMemoryBytes()
+{
+	size_t Bytes = Manager.RetainedBytes + ChunkPoolBytes() + SpareSectionBytes();
+	Bytes += (size_t)(Manager.VertexArena.Capacity - Manager.VertexArena.Used) * Manager.VertexArena.ElementSize;
+	for (Chunk* chunk : Manager.Chunks.Cells)
+	{
+		if (chunk && chunk->State == ChunkState::GENERATED) Bytes += RetainedChunkBytes(chunk);
+	}
+	return Bytes;
+}
+
+// Every GOVERNOR_INTERVAL_MS Compares Average Busy Time & World Memory Against Config. Going Over Either Pulls the
+// Radius in an Eighth at Once (& the Upload Budget Too When Slow), Only Calm Intervals in a Row Let it Back Out by One
+void GovernWorld(f32 FrameSeconds, f32 BusyMs)
+{
+	if (!Config.Governor) return;
+
+	Manager.GovernorElapsedMs += FrameSeconds * 1000.0;
+	Manager.GovernorBusyMs += BusyMs;
+	Manager.GovernorFrames++;
+	if (Manager.GovernorElapsedMs < GOVERNOR_INTERVAL_MS) return;
+
+	PROFILE_ZONE("GovernWorld");
+
+	f64 AverageMs = Manager.GovernorBusyMs / Manager.GovernorFrames;
+	Manager.GovernorElapsedMs = 0.0;
+	Manager.GovernorBusyMs = 0.0;
+	Manager.GovernorFrames = 0;
+
+	Manager.WorldBytes = WorldMemoryBytes();
+	const size_t Cap = (size_t)Config.MemoryCapMB * 1024 * 1024;
+	const bool Slow = AverageMs > Config.TargetFrameMs;
+	const bool Full = Manager.WorldBytes > Cap;
+
+	if (Slow)
+	{
+		Manager.UploadBudgetUs = std::max((u32)MIN_UPLOAD_BUDGET_US, Manager.UploadBudgetUs * 3 / 4);
+	}
+	if (Slow || Full)
+	{
+		Manager.CalmIntervals = 0;
+		SetRenderDistance(Manager.RenderDistance - std::max(1, Manager.RenderDistance / 8));
+		return;
+	}
+
+	// Calm Needs Headroom on Both so the Radius Doesn't Grow Straight Back Into What Pulled it In
+	if (AverageMs < Config.TargetFrameMs * 0.75 && Manager.WorldBytes < Cap / 10 * 9)
+	{
+		Manager.UploadBudgetUs = std::min(Config.UploadBudgetUs, Manager.UploadBudgetUs + Manager.UploadBudgetUs / 4);
+		if (++Manager.CalmIntervals >= GOVERNOR_GROW_INTERVALS && Manager.RenderDistance < Config.RenderDistance)
+		{
+			Manager.CalmIntervals = 0;
+			SetRenderDistance(Manager.RenderDistance + 1);
+		}
+	}
+	else
+	{
+		Manager.CalmIntervals = 0;
+	}
 }
 
 void UpdateWorld(const Camera camera)
 {
+	PROFILE_ZONE("UpdateWorld");
+
 	// Converts Cameras World Position into Chunk Coords
     s32 PlayerChunkX = floor_(camera.Position.x / CHUNK_SIZE);
     s32 PlayerChunkZ = floor_(camera.Position.z / CHUNK_SIZE);
 
-    LoadChunks(PlayerChunkX, PlayerChunkZ);
-    UnloadChunks(PlayerChunkX, PlayerChunkZ);
+    Manager.PlayerChunk = glm::ivec3(PlayerChunkX, 0, PlayerChunkZ);
+    Manager.Workers.SetFocus(Manager.PlayerChunk);
 
-	// Updates Queued Chunks, Amount Processed Per Frame Capped by CHUNKS_PER_FRAME
-    u8 ChunksProcessed = 0;
-    while (!Manager.UpdateQueue.empty() && ChunksProcessed++ != CHUNKS_PER_FRAME)
+    // The Loaded Square Only Changes When the Player Crosses Into Another Chunk
+    if (!Manager.Streamed)
+    {
+        UnloadChunks(PlayerChunkX, PlayerChunkZ);
+        LoadChunks(PlayerChunkX, PlayerChunkZ);
+        Manager.Streamed = true;
+    }
+    else if (Manager.PlayerChunk != Manager.StreamedChunk)
+    {
+        PROFILE_ZONE("StreamChunks");
+        StreamChunks(Manager.StreamedChunk, Manager.PlayerChunk);
+        UpdateChunkLods(Manager.StreamedChunk, Manager.PlayerChunk);
+    }
+    Manager.StreamedChunk = Manager.PlayerChunk;
+
+    DrainGeneratedChunks();
+    UploadChunkMeshes();
+}
+
+inline bool InRenderDistance(glm::ivec3 Position)
+{
+	return abs_(Position.x - Manager.PlayerChunk.x) <= Manager.RenderDistance && abs_(Position.z - Manager.PlayerChunk.z) <= Manager.RenderDistance;
+}
+
+// Level by Distance From the Player's Chunk, Measured the Same Square Way as Render Distance
+inline u8 ChunkLod(glm::ivec3 Position)
+{
+	s32 Distance = std::max(abs_(Position.x - Manager.PlayerChunk.x), abs_(Position.z - Manager.PlayerChunk.z));
+
+	u8 Lod = 0;
+	for (s32 Reach = LOD_BASE_DISTANCE; Distance > Reach && Lod < LOD_COUNT - 1; Reach *= 2)
 	{
-        glm::ivec3 pos = Manager.UpdateQueue.front();
-        Manager.UpdateQueue.pop();
+		Lod++;
+	}
+	return Lod;
+}
 
-        if (Manager.Chunks.find(pos) != Manager.Chunks.end())
-        {
-			UpdateChunk(Manager.Chunks[pos]);
-        }
-    }
+// Only Coarse Meshes Care, a Full Detail Border Culls Exactly Against Whatever Level is Beside It
+inline u8 FinerNeighbors(glm::ivec3 Position, u8 Lod)
+{
+	u8 Finer = 0;
+	if (!Lod) return Finer;
+
+	for (u8 i = 0; i < 4; ++i)
+	{
+		if (ChunkLod(Position + NeighborOffsets[i]) < Lod) Finer |= 1 << i;
+	}
+	return Finer;
+}
+
+// First Mesh Waits for Every In-Range Neighbor so Border Faces are Culled Without a Second Pass
+inline void MeshIfReady(Chunk* chunk)
+{
+	if (chunk->State != ChunkState::GENERATED || chunk->MeshRevision) return;
+
+	for (u8 i = 0; i < 4; ++i)
+	{
+		glm::ivec3 NeighborPosition = chunk->Position + NeighborOffsets[i];
+		if (InRenderDistance(NeighborPosition) && !GetChunk(NeighborPosition)) return;
+	}
+
+	QueueChunkMesh(chunk);
+}
+
+inline void RemeshNeighbor(Chunk* chunk, u8 Neighbor, u8 Sections)
+{
+	glm::ivec3 Position = chunk->Position + NeighborOffsets[Neighbor];
+	Chunk* Adjacent = GetChunk(Position);
+	if (Adjacent && Adjacent->MeshRevision)
+	{
+		QueueChunkMesh(Adjacent, Sections);
+	}
+
+	// A Retained Neighbor Forgets This Border so it Remeshes When Revived
+	auto it = Manager.Retained.find(Position);
+	if (it != Manager.Retained.end())
+	{
+		(*it->second)->MeshedNeighbors &= ~(1 << (Neighbor ^ 1));
+	}
+}
+
+inline void CreateChunk(glm::ivec3 Position)
+{
+	Chunk* chunk = AcquireChunk();
+	chunk->State = ChunkState::GENERATING;
+	chunk->Position = Position;
+	chunk->RequestedAt = ProfileNow();
+	chunk->GenerateJob = Manager.Workers.ReserveJobId();
+
+	if (!Manager.FreeSlots.empty())
+	{
+		chunk->Slot = Manager.FreeSlots.back();
+		Manager.FreeSlots.pop_back();
+	}
+	else
+	{
+		chunk->Slot = (u16)Manager.NextSlot++;
+	}
+
+	glm::ivec2 Origin(Position.x * CHUNK_SIZE, Position.z * CHUNK_SIZE);
+	glBindBuffer(GL_TEXTURE_BUFFER, Manager.OriginBuffer);
+	glBufferSubData(GL_TEXTURE_BUFFER, chunk->Slot * sizeof(glm::ivec2), sizeof(glm::ivec2), &Origin);
+	Manager.Chunks.Insert(chunk);
+
+	// Saved Chunks are Read Back on the I/O Thread, Others are Generated on a Worker
+	// Both Hand the Chunk Back Through Manager.Generated
+	chunk->LoadRequest = Manager.Regions.Load(chunk, [chunk]
+	{
+		PROFILE_COUNT(CHUNKS_LOADED, 1);
+		std::lock_guard<std::mutex> Lock(Manager.GeneratedMutex);
+		Manager.Generated.push_back(chunk);
+	},
+	[chunk, Id = chunk->GenerateJob]
+	{
+		// Id Was Reserved on the Main Thread, Position Never Changes Once the Chunk is Requested
+		// Two Pointer-Sized Captures Fit std::function's Inline Storage, so Neither Callback Allocates
+		Manager.Workers.Submit(chunk->Position, [chunk]
+		{
+			GenerateChunk(chunk);
+			PROFILE_COUNT(CHUNKS_GENERATED, 1);
+
+			std::lock_guard<std::mutex> Lock(Manager.GeneratedMutex);
+			Manager.Generated.push_back(chunk);
+		}, nullptr, Id);
+	});
+}
+
+inline void DrainGeneratedChunks()
+{
+	PROFILE_ZONE("DrainGeneratedChunks");
+
+	Manager.Arrived.clear();
+	{
+		std::lock_guard<std::mutex> Lock(Manager.GeneratedMutex);
+		Manager.Arrived.swap(Manager.Generated);
+	}
+
+	for (Chunk* chunk : Manager.Arrived)
+	{
+		// Chunk Left Range While its Worker Was Running
+		if (chunk->State == ChunkState::UNLOADED)
+		{
+			DeleteChunk(chunk);
+			continue;
+		}
+
+		chunk->State = ChunkState::GENERATED;
+		ChunkArrived(chunk);
+	}
+}
+
+// Shared by Freshly Generated & Revived Chunks, Meshes Whatever Can Now be Meshed
+inline void ChunkArrived(Chunk* chunk)
+{
+	if (!chunk->MeshRevision)
+	{
+		MeshIfReady(chunk);
+	}
+	else
+	{
+		// Revived With its Mesh: Redo it if a Border Changed While Away, Else Only Sections Whose Remesh Was Dropped
+		u8 Present = 0;
+		for (u8 i = 0; i < 4; ++i)
+		{
+			if (GetChunk(chunk->Position + NeighborOffsets[i])) Present |= 1 << i;
+		}
+
+		u8 Stale = 0;
+		for (u8 Section = 0; Section < SECTION_COUNT; ++Section)
+		{
+			if (chunk->Meshes[Section].Revision != chunk->Meshes[Section].Uploaded) Stale |= 1 << Section;
+		}
+
+		if (Present & ~chunk->MeshedNeighbors) QueueChunkMesh(chunk);
+		else if (Stale) QueueChunkMesh(chunk, Stale);
+	}
+
+	// Neighbors Either Take Their First Mesh Now or Remesh if They Were Built Without This Border
+	for (u8 i = 0; i < 4; ++i)
+	{
+		Chunk* Neighbor = GetChunk(chunk->Position + NeighborOffsets[i]);
+		if (!Neighbor) continue;
+
+		if (!Neighbor->MeshRevision)
+		{
+			MeshIfReady(Neighbor);
+		}
+		else if (!(Neighbor->MeshedNeighbors & (1 << (i ^ 1))))
+		{
+			QueueChunkMesh(Neighbor);
+		}
+	}
+}
+
+inline void RequestChunk(glm::ivec3 Position)
+{
+	if (Manager.Chunks.Find(Position)) return;
+
+	if (!ReviveChunk(Position))
+	{
+		CreateChunk(Position);
+	}
+}
+
+// Moves a Chunk That Left Range Into the Retention Cache, Blocks (& Optionally its Mesh) Stay Intact
+inline void RetainChunk(Chunk* chunk)
+{
+#if !RETAIN_GPU_MESHES
+	for (SectionMesh& Section : chunk->Meshes)
+	{
+		Manager.VertexArena.Free(&Section.VertexRange);
+		Section.IndexCount = 0;
+	}
+	chunk->MeshRevision = 0;
+#endif
+
+	if (Manager.SpareOrderNodes.empty())
+	{
+		Manager.RetainedOrder.push_front(chunk);
+	}
+	else
+	{
+		Manager.RetainedOrder.splice(Manager.RetainedOrder.begin(), Manager.SpareOrderNodes, Manager.SpareOrderNodes.begin());
+		Manager.RetainedOrder.front() = chunk;
+	}
+
+	if (Manager.SpareRetainedNodes.empty())
+	{
+		Manager.Retained[chunk->Position] = Manager.RetainedOrder.begin();
+	}
+	else
+	{
+		RetainedMap::node_type Node = std::move(Manager.SpareRetainedNodes.back());
+		Manager.SpareRetainedNodes.pop_back();
+		Node.key() = chunk->Position;
+		Node.mapped() = Manager.RetainedOrder.begin();
+		Manager.Retained.insert(std::move(Node));
+	}
+	Manager.RetainedBytes += RetainedChunkBytes(chunk);
+
+	EvictRetainedChunks();
+}
+
+inline bool ReviveChunk(glm::ivec3 Position)
+{
+	auto it = Manager.Retained.find(Position);
+	if (it == Manager.Retained.end()) return false;
+
+	Chunk* chunk = ForgetRetainedChunk(it);
+	Manager.Chunks.Insert(chunk);
+	ChunkArrived(chunk);
+	return true;
+}
+
+// Drops Least Recently Retained Chunks Until the Cache Fits its Budget, Edited Ones are Saved First
+inline void EvictRetainedChunks()
+{
+	while (!Manager.RetainedOrder.empty() && (Manager.RetainedBytes > (size_t)RETENTION_BUDGET_MB * 1024 * 1024 || Manager.Retained.size() > MAX_RETAINED_CHUNKS))
+	{
+		Chunk* chunk = ForgetRetainedChunk(Manager.Retained.find(Manager.RetainedOrder.back()->Position));
+
+		if (chunk->Dirty) Manager.Regions.Save(chunk);
+		DeleteChunk(chunk);
+	}
+}
+
+// Takes a Chunk Out of the Cache, Its List & Map Nodes are Kept for the Next RetainChunk
+inline Chunk* ForgetRetainedChunk(RetainedMap::iterator it)
+{
+	Chunk* chunk = *it->second;
+	Manager.RetainedBytes -= RetainedChunkBytes(chunk);
+	Manager.SpareOrderNodes.splice(Manager.SpareOrderNodes.begin(), Manager.RetainedOrder, it->second);
+	Manager.SpareRetainedNodes.push_back(Manager.Retained.extract(it));
+	return chunk;
+}
+
+inline size_t RetainedChunkBytes(const Chunk* chunk)
+{
+	size_t Bytes = sizeof(Chunk) + ChunkStorageBytes(chunk);
+	for (const SectionMesh& Section : chunk->Meshes)
+	{
+		Bytes += Section.VertexRange.Count * sizeof(ChunkVertex);
+	}
+	return Bytes;
+}
+
+// Uploads Finished Meshes Until the Upload Budget Runs Out, Leftovers Wait for the Next Frame
+inline void UploadChunkMeshes()
+{
+	PROFILE_ZONE("UploadChunkMeshes");
+
+	std::chrono::steady_clock::time_point Start = std::chrono::steady_clock::now();
+
+	{
+		std::lock_guard<std::mutex> Lock(Manager.MeshedMutex);
+		Manager.Uploading.insert(Manager.Uploading.end(), Manager.Meshed.begin(), Manager.Meshed.end());
+		Manager.Meshed.clear();
+	}
+
+	size_t Uploaded = 0;
+	while (Uploaded < Manager.Uploading.size())
+	{
+		ChunkMesh* Mesh = Manager.Uploading[Uploaded];
+
+		// Drop Meshes for Unloaded Chunks, Sections Superseded by a Newer Remesh are Skipped During Upload
+		// Mesh Buffers Full at Their Max Size Leave This & Later Meshes Queued, Retried Once Unloads Free Some Space
+		Chunk* chunk = GetChunk(Mesh->Position);
+		if (chunk && !UploadChunkMesh(chunk, Mesh)) break;
+
+		ReleaseChunkMesh(Mesh);
+		Uploaded++;
+
+		if (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - Start).count() >= Manager.UploadBudgetUs)
+		{
+			break;
+		}
+	}
+	Manager.Uploading.erase(Manager.Uploading.begin(), Manager.Uploading.begin() + Uploaded);
+}
+
+// Visits Every Position Within Radius of Current That Was Outside Radius of Previous:
+// Whole Columns Entered Along X, Then the Rows Entered Along Z Between Them
+template <typename Visitor>
+static void ForEachEnteredChunk(glm::ivec3 Previous, glm::ivec3 Current, s32 Radius, Visitor Visit)
+{
+	for (s32 x = Current.x - Radius; x <= Current.x + Radius; ++x)
+	{
+		bool ColumnEntered = abs_(x - Previous.x) > Radius;
+		for (s32 z = Current.z - Radius; z <= Current.z + Radius; ++z)
+		{
+			if (ColumnEntered || abs_(z - Previous.z) > Radius)
+			{
+				Visit(glm::ivec3(x, 0, z));
+			}
+			else
+			{
+				// Rest of This Column up to the Far Rows Was Already Covered
+				z = std::max(z, Previous.z + Radius);
+			}
+		}
+	}
+}
+
+// Loads the Rows & Columns Entering Render Distance and Unloads Those Leaving Unload Distance
+inline void StreamChunks(glm::ivec3 Previous, glm::ivec3 Current)
+{
+	// Leaving Chunks Go First, the Grid Cell an Entering Chunk Needs May Still Hold One
+	// Every Loaded Chunk Lies Within Unload Distance of Previous, so Only Positions Leaving That Square Can Go
+	const s32 UnloadDistance = Manager.RenderDistance + UNLOAD_MARGIN;
+	if (abs_(Current.x - Previous.x) > 2 * UnloadDistance || abs_(Current.z - Previous.z) > 2 * UnloadDistance)
+	{
+		UnloadChunks(Current.x, Current.z);
+	}
+	else
+	{
+		ForEachEnteredChunk(Current, Previous, UnloadDistance, UnloadChunk);
+	}
+
+	// A Jump Past the Whole Square (Teleport) Loads Everything, Ring Order Keeps the Nearest First
+	if (abs_(Current.x - Previous.x) > 2 * Manager.RenderDistance || abs_(Current.z - Previous.z) > 2 * Manager.RenderDistance)
+	{
+		LoadChunks(Current.x, Current.z);
+	}
+	else
+	{
+		ForEachEnteredChunk(Previous, Current, Manager.RenderDistance, RequestChunk);
+	}
+}
+
+// Bands Move With the Player, Chunks Whose Level or Finer Neighbors Changed are Remeshed From the Blocks They Hold
+// A Level Only Changes Between the Band Squares Around Previous & Current, Walked as Ring Deltas Like StreamChunks,
+// & Finer Neighbors Only Change Beside a Chunk Whose Level Did
+inline void UpdateChunkLods(glm::ivec3 Previous, glm::ivec3 Current)
+{
+	PROFILE_ZONE("UpdateChunkLods");
+
+	auto Refresh = [](glm::ivec3 Position)
+	{
+		for (u8 i = 0; i <= 4; ++i)
+		{
+			Chunk* chunk = GetChunk(i < 4 ? Position + NeighborOffsets[i] : Position);
+			if (!chunk || chunk->State != ChunkState::GENERATED || !chunk->MeshRevision) continue;
+
+			// QueueChunkMesh Stores the New Level, a Chunk Reached Twice is Only Remeshed Once
+			u8 Lod = ChunkLod(chunk->Position);
+			if (Lod != chunk->Lod || FinerNeighbors(chunk->Position, Lod) != chunk->FinerNeighbors)
+			{
+				QueueChunkMesh(chunk);
+			}
+		}
+	};
+
+	for (s32 Reach = LOD_BASE_DISTANCE, Band = 1; Band < LOD_COUNT; Reach *= 2, ++Band)
+	{
+		ForEachEnteredChunk(Previous, Current, Reach, Refresh);
+		ForEachEnteredChunk(Current, Previous, Reach, Refresh);
+	}
 }
 
-inline void LoadChunks(const s32 PlayerChunkX, const s32 PlayerChunkZ) 
+// Rings From FirstRadius Out to the Render Distance, Nearest First
+inline void LoadChunks(const s32 PlayerChunkX, const s32 PlayerChunkZ, const s32 FirstRadius) 
 {
-    u8 CurrentRadius = 0;
-    while (CurrentRadius <= RENDER_DISTANCE)
+    u8 CurrentRadius = (u8)FirstRadius;
+    while (CurrentRadius <= Manager.RenderDistance)
     {
         // Forward
 		for (s8 i = -CurrentRadius; i <= CurrentRadius; ++i)
 		{
 			glm::ivec3 pos(i + PlayerChunkX, 0, CurrentRadius + PlayerChunkZ);
-			if (Manager.Chunks.find(pos) == Manager.Chunks.end())
-			{
-				Chunk* chunk = new Chunk;
-				chunk->Position = pos;
-				chunk->Blocks.resize(CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE, BlockType::AIR);
-				Manager.Chunks[pos] = chunk;
-				GenerateChunk(chunk);
-				Manager.UpdateQueue.push(pos);
-			}
+			RequestChunk(pos);
 		}
         // Right 
 		for (s8 i = -CurrentRadius + 1; i <= CurrentRadius; ++i)
 		{
 			glm::ivec3 pos(CurrentRadius + PlayerChunkX, 0, i + PlayerChunkZ);
-			if (Manager.Chunks.find(pos) == Manager.Chunks.end())
-			{
-				Chunk* chunk = new Chunk;
-				chunk->Position = pos;
-				chunk->Blocks.resize(CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE, BlockType::AIR);
-				Manager.Chunks[pos] = chunk;
-				GenerateChunk(chunk);
-				Manager.UpdateQueue.push(pos);
-			}
+			RequestChunk(pos);
 		}
         // Backward
 		for (s8 i = -CurrentRadius + 1; i <= CurrentRadius; ++i)
 		{
 			glm::ivec3 pos(i + PlayerChunkX, 0, -CurrentRadius + PlayerChunkZ);
-			if (Manager.Chunks.find(pos) == Manager.Chunks.end())
-			{
-				Chunk* chunk = new Chunk;
-				chunk->Position = pos;
-				chunk->Blocks.resize(CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE, BlockType::AIR);
-				Manager.Chunks[pos] = chunk;
-				GenerateChunk(chunk);
-				Manager.UpdateQueue.push(pos);
-			}
+			RequestChunk(pos);
 		}
         // Left
 		for (s8 i = -CurrentRadius; i <= CurrentRadius - 1; ++i)
 		{
 			glm::ivec3 pos(-CurrentRadius + PlayerChunkX, 0, i + PlayerChunkZ);
-			if (Manager.Chunks.find(pos) == Manager.Chunks.end())
-			{
-				Chunk* chunk = new Chunk;
-				chunk->Position = pos;
-				chunk->Blocks.resize(CHUNK_SIZE * CHUNK_HEIGHT * CHUNK_SIZE, BlockType::AIR);
-				Manager.Chunks[pos] = chunk;
-				GenerateChunk(chunk);
-				Manager.UpdateQueue.push(pos);
-			}
+			RequestChunk(pos);
 		}
         CurrentRadius++;
     }
 }
 
+// Full Scan, Only Needed for the First Frame, Jumps Past the Whole Unload Square & a Shrinking Render Distance
 inline void UnloadChunks(const s32 PlayerChunkX, const s32 PlayerChunkZ) {
-	for (auto it = Manager.Chunks.begin(); it != Manager.Chunks.end();)
+	const s32 UnloadDistance = Manager.RenderDistance + UNLOAD_MARGIN;
+	std::vector<glm::ivec3> Leaving;
+	for (Chunk* chunk : Manager.Chunks.Cells)
     {
-        s32 ChunkX = it->first.x;
-        s32 ChunkZ = it->first.z;
-
-        if (abs_(ChunkX - PlayerChunkX) > RENDER_DISTANCE || abs_(ChunkZ - PlayerChunkZ) > RENDER_DISTANCE)
+        if (chunk && (abs_(chunk->Position.x - PlayerChunkX) > UnloadDistance || abs_(chunk->Position.z - PlayerChunkZ) > UnloadDistance))
         {
-			DeleteChunk(it->second);
-            it = Manager.Chunks.erase(it);
-        }
-		else
+			Leaving.push_back(chunk->Position);
+		}
+	}
+
+	for (glm::ivec3 Position : Leaving)
+	{
+		UnloadChunk(Position);
+	}
+}
+
+inline void UnloadChunk(glm::ivec3 Position)
+{
+	Chunk* chunk = Manager.Chunks.Find(Position);
+	if (!chunk) return;
+
+	// A Load or Generate That Already Started Can't be Recalled, its Thread Hands the Chunk Back Later
+	// Only the Chunk's Own Generate Job Counts, Stale Mesh Jobs From an Earlier Chunk Here Share its Position
+	if (chunk->State == ChunkState::GENERATED)
+	{
+		RetainChunk(chunk);
+	}
+	else if (!Manager.Regions.CancelLoad(chunk->LoadRequest) && !Manager.Workers.Cancel(chunk->GenerateJob))
+	{
+		chunk->State = ChunkState::UNLOADED;
+	}
+	else
+	{
+		DeleteChunk(chunk);
+	}
+	Manager.Chunks.Erase(Position);
+
+	// Chunks Left Waiting on This One No Longer Need to
+	for (u8 i = 0; i < 4; ++i)
+	{
+		if (Chunk* Neighbor = GetChunk(Position + NeighborOffsets[i]))
 		{
-			++it;
+			MeshIfReady(Neighbor);
 		}
-    }
+	}
+}
+
+// Copies Each Finished Section Into the Shared Buffers, a Section's Old Ranges are Released Only Once the New Ones Exist
+inline bool UploadChunkMesh(Chunk* chunk, ChunkMesh* Mesh)
+{
+	for (u8 Section = 0; Section < SECTION_COUNT; ++Section)
+	{
+		SectionMesh& Target = chunk->Meshes[Section];
+		if (!(Mesh->Sections & (1 << Section)) || Target.Revision != Mesh->Revision) continue;
+
+		u32 VertexCount = Mesh->VertexStart[Section + 1] - Mesh->VertexStart[Section];
+
+		ArenaRange VertexRange;
+		if (!AllocateMeshRange(Manager.VertexArena, VertexCount, &VertexRange)) return false;
+		Manager.VertexArena.Upload(VertexRange, Mesh->Vertices.data() + Mesh->VertexStart[Section]);
+
+		Manager.VertexArena.Free(&Target.VertexRange);
+		Target.VertexRange = VertexRange;
+		Target.IndexCount = VertexCount / 4 * 6;
+		Target.MinY = Mesh->MinY[Section];
+		Target.MaxY = Mesh->MaxY[Section];
+		Target.Connectivity = Mesh->Connectivity[Section];
+		Target.Uploaded = Mesh->Revision;
+		PROFILE_COUNT(MESHES_UPLOADED, 1);
+
+		// Uploaded Sections Aren't Redone if the Mesh is Retried
+		Mesh->Sections &= ~(1 << Section);
+	}
+
+	if (chunk->RequestedAt)
+	{
+		if (Manager.TrackLatency) Manager.VisibleLatencies.push_back((f32)((ProfileNow() - chunk->RequestedAt) / 1e6));
+		chunk->RequestedAt = 0;
+	}
+	return true;
+}
+
+// Falls Back to Compacting When Free Space is Only Fragmented, Then to Growing the Buffer
+inline bool AllocateMeshRange(BufferArena& Arena, u32 Count, ArenaRange* Range)
+{
+	if (Arena.Allocate(Count, Range)) return true;
+
+	if (Arena.Capacity - Arena.Used >= Count)
+	{
+		std::vector<ArenaRange*> Live;
+		Live.reserve((Manager.Chunks.Size() + Manager.RetainedOrder.size()) * SECTION_COUNT);
+		for (Chunk* chunk : Manager.Chunks.Cells)
+		{
+			if (!chunk) continue;
+			for (SectionMesh& Section : chunk->Meshes)
+			{
+				Live.push_back(&Section.VertexRange);
+			}
+		}
+		for (Chunk* chunk : Manager.RetainedOrder)
+		{
+			for (SectionMesh& Section : chunk->Meshes)
+			{
+				Live.push_back(&Section.VertexRange);
+			}
+		}
+		Arena.Compact(Live);
+		BindMeshArenas();
+
+		if (Arena.Allocate(Count, Range)) return true;
+	}
+
+	if (!Arena.Grow(Count)) return false;
+	BindMeshArenas();
+	return Arena.Allocate(Count, Range);
 }
 
-void RenderWorld(Shader& shader)
+// Points the Shared VAO at the Current Arena Buffers, Needed Again Whenever One is Replaced
+inline void BindMeshArenas()
 {
-    for (auto& [key, chunk] : Manager.Chunks)
+	glBindVertexArray(Manager.VAO);
+	glBindBuffer(GL_ARRAY_BUFFER, Manager.VertexArena.Buffer);
+	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, Manager.QuadIndexBuffer);
+
+#if PACKED_VERTICES
+	// Both Words are Decoded in vertex.glsl
+	glVertexAttribIPointer(0, 2, GL_UNSIGNED_INT, sizeof(PackedVertex), (void*)0);
+	glEnableVertexAttribArray(0);
+#else
+	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Position));
+	glEnableVertexAttribArray(0);
+
+	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, Normal));
+	glEnableVertexAttribArray(1);
+
+	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, TexCoords));
+	glEnableVertexAttribArray(2);
+#endif
+
+	glBindVertexArray(0);
+}
+
+void RenderWorld(const glm::mat4& ViewProjection, const glm::vec3& Eye)
+{
+	PROFILE_ZONE("RenderWorld");
+
+	Manager.ViewFrustum.Update(ViewProjection);
+
+	// Frame Stamps Wrap After 2^32 Frames, Skipping 0 so Fresh Sections Never Look Visited
+	if (!++Manager.OcclusionFrame) Manager.OcclusionFrame = 1;
+	bool Occluding = false;
+	if (Manager.OcclusionCulling)
+	{
+		PROFILE_ZONE("OcclusionWalk");
+		Occluding = WalkVisibleSections(Manager.Chunks, Manager.ViewFrustum, Eye, Manager.OcclusionFrame, Manager.OcclusionQueue);
+	}
+
+	Manager.CullSections.clear();
+	Manager.CullBoxes.Clear();
+
+    // Cells Walk the Grid Row by Row so Neighboring Chunks' Sections Sit Together in the Draw List
+    for (Chunk* chunk : Manager.Chunks.Cells)
     {
-		// Calculates Chunks World Position
-        glm::vec3 WorldPosition(chunk->Position.x * CHUNK_SIZE, chunk->Position.y * CHUNK_HEIGHT, chunk->Position.z * CHUNK_SIZE);
-
-		// Passes Chunks Position in World Space to Shader Before Rendering
-        glm::mat4 model = glm::translate(glm::mat4(1.0f), WorldPosition);
-        shader.SetMat4("Model", model);
-
-        glBindVertexArray(chunk->VAO);
-        glDrawElements(GL_TRIANGLES, chunk->Indices.size(), GL_UNSIGNED_INT, 0);
-		glBindVertexArray(0);
-    } 
-}
\ No newline at end of file
+		if (!chunk) continue;
+		for (SectionMesh& Section : chunk->Meshes)
+		{
+			// Skip Sections That Haven't Been Meshed Yet or Have Nothing to Draw
+			if (!Section.IndexCount) continue;
+
+			// Blocks are Centered on Integer Coords, Box Spans Only the Heights the Mesh Actually Reaches
+			glm::vec3 Min(chunk->Position.x * CHUNK_SIZE - BLOCK_RENDER_SIZE, Section.MinY - BLOCK_RENDER_SIZE, chunk->Position.z * CHUNK_SIZE - BLOCK_RENDER_SIZE);
+			glm::vec3 Max(Min.x + CHUNK_SIZE, Section.MaxY - BLOCK_RENDER_SIZE, Min.z + CHUNK_SIZE);
+
+			Manager.CullSections.push_back(&Section);
+			Manager.CullBoxes.Add(Min, Max);
+		}
+    }
+
+	Manager.ViewFrustum.Cull(Manager.CullBoxes, Manager.CullVisible);
+
+	Manager.DrawCounts.clear();
+	Manager.DrawOffsets.clear();
+	Manager.DrawBaseVertices.clear();
+	Manager.Stats = {};
+
+	for (size_t i = 0; i < Manager.CullSections.size(); ++i)
+	{
+		const SectionMesh* Section = Manager.CullSections[i];
+		u32 Triangles = Section->IndexCount / 3;
+
+		if (!Manager.CullVisible[i])
+		{
+			Manager.Stats.SectionsCulled++;
+			Manager.Stats.TrianglesCulled += Triangles;
+			continue;
+		}
+		if (Occluding && Section->VisibleFrame != Manager.OcclusionFrame)
+		{
+			Manager.Stats.SectionsCulled++;
+			Manager.Stats.TrianglesCulled += Triangles;
+			Manager.Stats.SectionsOccluded++;
+			Manager.Stats.TrianglesOccluded += Triangles;
+			continue;
+		}
+		Manager.Stats.SectionsDrawn++;
+		Manager.Stats.TrianglesDrawn += Triangles;
+
+		// Shared Indices Count From 0, Base Vertex Shifts Them Onto the Section's Vertices 16-Bit Range at a Time
+		for (u32 Index = 0; Index < Section->IndexCount; Index += QUADS_PER_DRAW * 6)
+		{
+			Manager.DrawCounts.push_back((GLsizei)std::min<u32>(Section->IndexCount - Index, QUADS_PER_DRAW * 6));
+			Manager.DrawOffsets.push_back(nullptr);
+			Manager.DrawBaseVertices.push_back((GLint)(Section->VertexRange.Offset + Index / 6 * 4));
+		}
+	}
+
+	if (Manager.DrawCounts.empty()) return;
+
+#if PACKED_VERTICES
+	glActiveTexture(GL_TEXTURE0 + ORIGIN_TEXTURE_UNIT);
+	glBindTexture(GL_TEXTURE_BUFFER, Manager.OriginTexture);
+	glActiveTexture(GL_TEXTURE0);
+#endif
+
+	glBindVertexArray(Manager.VAO);
+	glMultiDrawElementsBaseVertex(GL_TRIANGLES, Manager.DrawCounts.data(), GL_UNSIGNED_SHORT, Manager.DrawOffsets.data(), (GLsizei)Manager.DrawCounts.size(), Manager.DrawBaseVertices.data());
+	PROFILE_COUNT(DRAW_CALLS, 1);
+	PROFILE_COUNT(TRIANGLES, Manager.Stats.TrianglesDrawn);
+	glBindVertexArray(0);
+}
@@ -1,40 +1,173 @@
 #ifndef __CHUNKMANAGER_H__
 #define __CHUNKMANAGER_H__
 
-#include <queue>
+#include <list>
+#include <mutex>
 #include <unordered_map>
+#include <vector>
 
 #include "utils/common.h"
 #include "utils/camera.h"
 #include "utils/shader.h"
+#include "utils/frustum.h"
+#include "utils/workerpool.h"
 #include "chunk.h"
+#include "chunkgrid.h"
+#include "occlusion.h"
+#include "region.h"
+#include "settings.h"
 
-#define RENDER_DISTANCE 16
-#define CHUNKS_PER_FRAME 1 
+#define LOD_BASE_DISTANCE 6 // Chunks This Close Mesh at Full Detail, Each Coarser Level Reaches Twice as Far as the One Before
+
+// Chunks Stay Loaded Until They're UNLOAD_MARGIN Past the Render Distance, Then Wait in the Retention Cache
+// Until it Runs Over Budget so Walking Back Revives Them Without Regenerating
+#define UNLOAD_MARGIN 2
+#define RETENTION_BUDGET_MB 64
+#define MAX_RETAINED_CHUNKS 16384 // Keeps Retained + Loaded Chunks Well Inside MAX_CHUNK_SLOTS
+#define RETAIN_GPU_MESHES 1 // 0 Frees Mesh Ranges on Retention, Revived Chunks are Remeshed
+
+// Shared Mesh Buffers Start Here and Double on Demand up to the Max, Sizes in Elements
+#define VERTEX_ARENA_CAPACITY (1 << 21)
+#define VERTEX_ARENA_MAX_CAPACITY (1 << 24)
+#define QUADS_PER_DRAW 16384 // Quads the Shared 16-Bit Index Buffer Covers, Bigger Sections Take Several Draws
+
+#define MAX_CHUNK_SLOTS 65536 // Slot Has 16 Bits in PackedVertex
+#define GOVERNOR_INTERVAL_MS 500.0 // Busy Time is Averaged This Long Before the Governor Acts
+#define GOVERNOR_GROW_INTERVALS 4 // Calm Intervals in a Row Before the Radius Grows Back by One
+
+#define ORIGIN_TEXTURE_UNIT 1 // Unit the Chunk Origin Table is Bound to, vertex.glsl's ChunkOrigins Sampler Points Here
 
 typedef struct
 {
 	size_t operator()(const glm::ivec3& pos) const
     {
-		size_t h1 = std::hash<int>()(pos.x);
-		size_t h2 = std::hash<int>()(pos.y);
-		size_t h3 = std::hash<int>()(pos.z);
-		return h1 ^ (h2 << 1) ^ (h3 << 2);
+		// Coordinates are Small & Close Together, a Full 64-Bit Mix Spreads Them Over Every Bucket
+		u64 Key = ((u64)(u32)pos.x << 32 | (u32)pos.z) ^ ((u64)(u32)pos.y * 0x9E3779B97F4A7C15ull);
+		Key ^= Key >> 33;
+		Key *= 0xFF51AFD7ED558CCDull;
+		Key ^= Key >> 33;
+		Key *= 0xC4CEB9FE1A85EC53ull;
+		Key ^= Key >> 33;
+		return (size_t)Key;
 	}
 } ChunkHash;
 
+typedef std::unordered_map<glm::ivec3, std::list<Chunk*>::iterator, ChunkHash> RetainedMap;
+
+// Counters for the Last RenderWorld Call
+typedef struct
+{
+	u32 SectionsDrawn;
+	u32 SectionsCulled;
+	u64 TrianglesDrawn;
+	u64 TrianglesCulled;
+	u32 SectionsOccluded; // Inside the Frustum but Sealed Off From the Camera, Also Counted in SectionsCulled
+	u64 TrianglesOccluded;
+} RenderStats;
+
 typedef struct 
 {
-	std::queue<glm::ivec3> UpdateQueue;
-	std::unordered_map<glm::ivec3, Chunk*, ChunkHash> Chunks;
+	ChunkGrid Chunks; // Every Chunk Within the Unload Distance, Generating or Generated, Sized for MAX_RENDER_DISTANCE
+
+	WorkerPool Workers; // Terrain Generation & Meshing Threads
+	RegionStore Regions; // Saved Chunks, Loaded & Written on its Own I/O Thread
+
+	// Out of Range Chunks Kept Whole, Most Recently Retained at the Front
+	std::list<Chunk*> RetainedOrder;
+	RetainedMap Retained;
+	size_t RetainedBytes;
+	std::list<Chunk*> SpareOrderNodes; // Nodes of Revived & Evicted Chunks, Reused so Retaining Never Allocates
+	std::vector<RetainedMap::node_type> SpareRetainedNodes;
+
+	std::mutex GeneratedMutex;
+	std::vector<Chunk*> Generated; // Chunks Finished by Workers, Drained on the Main Thread
+	std::vector<Chunk*> Arrived; // Swapped With Generated Each Frame so Neither Reallocates
+	std::mutex MeshedMutex;
+	std::vector<ChunkMesh*> Meshed; // Meshes Finished by Workers, Uploaded on the GL Thread
+	std::vector<ChunkMesh*> Uploading; // Taken From Meshed, Front Ones Still Waiting on Buffer Space
+	u32 MeshRevision;
+	u8 Mesher; // MeshingMode Used for New Meshes
+	glm::ivec3 PlayerChunk;
+	glm::ivec3 StreamedChunk; // Player Chunk the Loaded Square Was Last Brought Up to Date For
+	bool Streamed;
+	s32 RenderDistance; // Radius Streamed Right Now, Config.RenderDistance Unless the Governor Pulled it In
+	u32 UploadBudgetUs; // Likewise for Config.UploadBudgetUs
+
+	// Governor Averages Over the Current Interval & What it Last Measured
+	f64 GovernorElapsedMs;
+	f64 GovernorBusyMs;
+	u32 GovernorFrames;
+	u32 CalmIntervals;
+	size_t WorldBytes;
+
+	// Every Chunk Mesh Lives in One Vertex Buffer and is Drawn by One glMultiDrawElementsBaseVertex
+	// Quads All Share the Same Index Pattern, so One Static Index Buffer Serves Every Section
+	u32 VAO;
+	BufferArena VertexArena;
+	u32 QuadIndexBuffer;
+	u32 OriginBuffer, OriginTexture; // Texture Buffer of Chunk World Origins Indexed by Slot
+	std::vector<u16> FreeSlots;
+	u32 NextSlot;
+
+	// Draw Lists Rebuilt Every Frame, Kept Here so They Don't Reallocate
+	std::vector<GLsizei> DrawCounts;
+	std::vector<const void*> DrawOffsets;
+	std::vector<GLint> DrawBaseVertices;
+
+	// Meshed Sections & Their Bounds, Tested Against the Camera Frustum Before Drawing
+	Frustum ViewFrustum;
+	std::vector<const SectionMesh*> CullSections;
+	BoxList CullBoxes;
+	std::vector<u8> CullVisible;
+	RenderStats Stats;
+
+	// Section Walk Through Connected Air, Sections it Never Reaches are Left Out Even Inside the Frustum
+	bool OcclusionCulling;
+	u32 OcclusionFrame; // Stamp for SectionMesh::VisibleFrame, 0 is Never Used
+	std::vector<OcclusionStep> OcclusionQueue;
+
+	// Milliseconds From CreateChunk to the Chunk's First Uploaded Mesh, Only Collected While TrackLatency is Set
+	bool TrackLatency;
+	std::vector<f32> VisibleLatencies;
 } ChunkManager;
 
 inline ChunkManager Manager; // Global Chunk Manager
 
-void RenderWorld(Shader& shader);
+void InitWorld(const char* WorldDirectory = WORLD_DIRECTORY);
+void ShutdownWorld();
+void RenderWorld(const glm::mat4& ViewProjection, const glm::vec3& Eye);
 void UpdateWorld(const Camera camera);
 void SetBlock(Chunk* chunk, glm::ivec3 BlockIndex, u8 CurrentHeldBlock, bool Mode);
-inline void LoadChunks(const s32 PlayerChunkX, const s32 PlayerChunkZ);
+Chunk* GetChunk(glm::ivec3 Position);
+void QueueChunkMesh(Chunk* chunk, u8 Sections = ALL_SECTIONS);
+void DeleteChunk(Chunk* chunk);
+void SetMeshingMode(u8 Mode);
+void ApplySettings();
+void SetRenderDistance(s32 Distance);
+void GovernWorld(f32 FrameSeconds, f32 BusyMs);
+size_t WorldMemoryBytes();
+inline bool InRenderDistance(glm::ivec3 Position);
+inline u8 ChunkLod(glm::ivec3 Position);
+inline u8 FinerNeighbors(glm::ivec3 Position, u8 Lod);
+inline void UpdateChunkLods(glm::ivec3 Previous, glm::ivec3 Current);
+inline void MeshIfReady(Chunk* chunk);
+inline void RemeshNeighbor(Chunk* chunk, u8 Neighbor, u8 Sections = ALL_SECTIONS);
+inline void CreateChunk(glm::ivec3 Position);
+inline void RequestChunk(glm::ivec3 Position);
+inline void ChunkArrived(Chunk* chunk);
+inline void RetainChunk(Chunk* chunk);
+inline bool ReviveChunk(glm::ivec3 Position);
+inline void EvictRetainedChunks();
+inline Chunk* ForgetRetainedChunk(RetainedMap::iterator it);
+inline size_t RetainedChunkBytes(const Chunk* chunk);
+inline void DrainGeneratedChunks();
+inline void UploadChunkMeshes();
+inline bool UploadChunkMesh(Chunk* chunk, ChunkMesh* Mesh);
+inline bool AllocateMeshRange(BufferArena& Arena, u32 Count, ArenaRange* Range);
+inline void BindMeshArenas();
+inline void StreamChunks(glm::ivec3 Previous, glm::ivec3 Current);
+inline void LoadChunks(const s32 PlayerChunkX, const s32 PlayerChunkZ, const s32 FirstRadius = 0);
 inline void UnloadChunks(const s32 PlayerChunkX, const s32 PlayerChunkZ);
+inline void UnloadChunk(glm::ivec3 Position);
 
 #endif
@@ -1,17 +1,68 @@
 #include "main.h"
 
-int main()
+// --record <File>         Save Every Tick's Camera & Block Edits to File on Exit
+// --replay <File|Name>    Play a Recorded File or a Built-in Path ("sprint", "build") at a Fixed dt, Then Report
+// --headless              Replay in a Hidden Window Without Presenting Frames
+// --max-p99 <Ms>          Exit With 1 When the Replay's p99 Frame Time Goes Over Ms
+// --settings <File>       Read Settings From File Instead of settings.cfg, Replays Use Defaults Without It
+int main(int argc, char** argv)
 {
+    const char* RecordFile = nullptr;
+    const char* ReplayName = nullptr;
+    const char* SettingsFile = nullptr;
+    bool Headless = false;
+    f64 MaxP99 = 0.0;
+
+    for (s32 i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--record") == 0 && i + 1 < argc)       RecordFile = argv[++i];
+        else if (strcmp(argv[i], "--replay") == 0 && i + 1 < argc)  ReplayName = argv[++i];
+        else if (strcmp(argv[i], "--max-p99") == 0 && i + 1 < argc) MaxP99 = atof(argv[++i]);
+        else if (strcmp(argv[i], "--settings") == 0 && i + 1 < argc) SettingsFile = argv[++i];
+        else if (strcmp(argv[i], "--headless") == 0)                Headless = true;
+        else
+        {
+            fprintf(stderr, "Usage: %s [--record File] [--replay File|sprint|build] [--headless] [--max-p99 Ms] [--settings File]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    Replaying = ReplayName != nullptr;
+    Recording = RecordFile != nullptr && !Replaying;
+    Headless = Headless && Replaying;
+    if (Replaying && !BuildReferencePath(ReplayName, &ReplayPath) && !ReplayPath.Load(ReplayName))
+    {
+        fprintf(stderr, "Couldn't Load Replay '%s'\n", ReplayName);
+        return 1;
+    }
+
+    // A Missing Default File is Written Out so There's Something to Edit, Replays Only Read One Named Explicitly
+    if (SettingsFile)
+    {
+        SettingsPath = SettingsFile;
+        if (!LoadSettings(SettingsPath, &Config))
+        {
+            fprintf(stderr, "Couldn't Load Settings '%s'\n", SettingsPath);
+            return 1;
+        }
+    }
+    else if (!Replaying && !LoadSettings(SettingsPath, &Config))
+    {
+        SaveSettings(SettingsPath, Config);
+    }
+
     glfwInit();
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
+    if (Headless) glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
 
     GLFWwindow* Window = glfwCreateWindow(WindowWidth, WindowHeight, "Too Many Voxels!", NULL, NULL);
     if (!Window) return -1;
 
     glfwMakeContextCurrent(Window);
     gladLoadGLLoader((GLADloadproc)glfwGetProcAddress);
+    if (Replaying) glfwSwapInterval(0); // Frame Times Should Measure Work, Not Vsync
 
     glfwSetInputMode(Window, GLFW_CURSOR, GLFW_CURSOR_DISABLED);
     glfwSetCursorPos(Window, WindowWidth / 2.0, WindowHeight / 2.0);
@@ -23,13 +74,37 @@ int main()
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
 
-    Shader WorldShader("assets/shaders/vertex.glsl", "assets/shaders/fragment.glsl");
-    Shader OutlineShader("assets/shaders/outlinevertex.glsl", "assets/shaders/outlinefragment.glsl");
-    Shader CrosshairShader("assets/shaders/crosshairvertex.glsl", "assets/shaders/crosshairfragment.glsl");
+    Shader WorldShader("assets/shaders/vertex.glsl", "assets/shaders/fragment.glsl", CHUNK_SHADER_DEFINES);
+    Shader DebugShader("assets/shaders/debugvertex.glsl", "assets/shaders/debugfragment.glsl");
     LoadTexture("assets/gfx/textureatlas.png");
 
+    // Camera Matrices Live in One Uniform Block Both Programs Read, Samplers Never Change Units
+    UniformBuffer CameraBlock;
+    CameraBlock.Create(sizeof(CameraUniforms), CAMERA_UNIFORM_BINDING);
+    WorldShader.BindUniformBlock("Camera", CAMERA_UNIFORM_BINDING);
+    DebugShader.BindUniformBlock("Camera", CAMERA_UNIFORM_BINDING);
+    WorldShader.Use();
+    WorldShader.SetInt("TextureAtlas", 0);
+    WorldShader.SetInt("ChunkOrigins", ORIGIN_TEXTURE_UNIT);
+
+    // Replays Start From Freshly Generated Terrain Every Time
+    if (Replaying)
+    {
+        std::error_code Error;
+        std::filesystem::remove_all(REPLAY_WORLD_DIRECTORY, Error);
+        InitWorld(REPLAY_WORLD_DIRECTORY);
+        Manager.TrackLatency = true;
+    }
+    else
+    {
+        InitWorld();
+    }
+    Debug.Create();
+
     f64 LastTime = glfwGetTime();
     f64 CurrentTime = 0.0;
+    f64 LastTitleTime = 0.0;
+    u32 ReplayTick = 0;
 
     while (!glfwWindowShouldClose(Window))
     {
@@ -37,10 +112,22 @@ int main()
 
         CurrentTime = glfwGetTime();
         dt = (f32)(CurrentTime - LastTime);
+        if (Replaying && Tick > 1) Replay.FrameMs.push_back((CurrentTime - LastTime) * 1000.0);
 		LastTime = CurrentTime;
 
-        ProcessInput(Window);         
-        camera.Update(Window, dt);		
+        if (Replaying)
+        {
+            if (ReplayTick == ReplayPath.Ticks.size()) break;
+
+            dt = 1.0f / ReplayPath.TickRate;
+            if (StepReplay(ReplayPath.Ticks[ReplayTick])) ReplayTick++;
+        }
+        else
+        {
+            ProcessInput(Window);
+            camera.Update(Window, dt);
+            if (Recording) ReplayPath.RecordTick(camera.Position, camera.Yaw, camera.Pitch, camera.FOV);
+        }
         UpdateWorld(camera); 
 
 		RaycastHit = Raycast(camera.Position, camera.Direction);
@@ -49,35 +136,69 @@ int main()
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
         // Render World
+        CameraUniforms CameraData;
+        CameraData.View = camera.ViewMatrix();
+        CameraData.Projection = camera.ProjectionMatrix();
+        CameraData.ViewProjection = CameraData.Projection * CameraData.View;
+        CameraBlock.Update(&CameraData);
+
 		WorldShader.Use();
-        WorldShader.SetMat4("View", camera.ViewMatrix());
-        WorldShader.SetMat4("Projection", camera.ProjectionMatrix());
-        WorldShader.SetInt("TextureAtlas", 0);
-        RenderWorld(WorldShader);
-
-		// Render Crosshair
-		CrosshairShader.Use();
-		CrosshairShader.SetVec3("Color", glm::vec3(0.0f));
-        CrosshairShader.SetMat4("View", glm::mat4(1.0f));
-		CrosshairShader.SetMat4("Model", glm::mat4(1.0f));
-		CrosshairShader.SetMat4("Projection", glm::ortho(0.0f, (f32)WindowWidth, 0.0f, (f32)WindowHeight));
-		RenderCrosshair();
+        PROFILE_GPU_BEGIN();
+        RenderWorld(CameraData.ViewProjection, camera.Position);
+        PROFILE_GPU_END();
 
-        // Render Block Selection Outline
-        if (RaycastHit.CurrentChunk && RaycastHit.RayChunk)
+        if (CurrentTime - LastTitleTime >= 1.0)
+        {
+            UpdateWindowTitle(Window);
+            LastTitleTime = CurrentTime;
+        }
+
+        // Crosshair, Block Selection Outline & Diagnostics All Go Out in One Debug Draw Flush
+		RenderCrosshair();
+        if (RaycastHit.CurrentChunk)
         {
-            OutlineShader.Use();
-			OutlineShader.SetVec3("Color", glm::vec3(0.0f));
-            OutlineShader.SetMat4("View", camera.ViewMatrix());
-            OutlineShader.SetMat4("Model", glm::mat4(1.0f));
-            OutlineShader.SetMat4("Projection", camera.ProjectionMatrix());
             RenderPlacementOutline(RaycastHit.CurrentChunk, RaycastHit.BreakPosition);
         }
+        if (ShowDiagnostics)
+        {
+            RenderDiagnostics();
+        }
+        Debug.Flush(DebugShader, glm::ortho(0.0f, (f32)WindowWidth, 0.0f, (f32)WindowHeight));
+
+        // Busy Time Leaves Out the Vsync Wait in SwapBuffers, GPU Bound Frames Show Up Through the World Pass Timer
+        f32 BusyMs = (f32)std::max((glfwGetTime() - CurrentTime) * 1000.0, Profile.LastGpuWorldNs / 1e6);
+        GovernWorld(dt, BusyMs);
+
+        {
+            PROFILE_ZONE("SwapBuffers");
+            if (Headless) glFinish(); // Nothing is Shown, Waiting Keeps GPU Time in the Frame
+            else glfwSwapBuffers(Window);
+            glfwPollEvents();
+        }
+        PROFILE_FRAME_END();
+    }
 
-        glfwSwapBuffers(Window);
-        glfwPollEvents();    
+    s32 Result = 0;
+    if (Replaying)
+    {
+        Replay.VisibleMs = Manager.VisibleLatencies;
+        f64 P99 = PrintReplayReport(ReplayName, Replay);
+        if (MaxP99 > 0.0 && P99 > MaxP99)
+        {
+            printf("  p99 %.2f ms is over the %.2f ms budget\n", P99, MaxP99);
+            Result = 1;
+        }
+    }
+    if (Recording && !ReplayPath.Save(RecordFile))
+    {
+        fprintf(stderr, "Couldn't Write Recording '%s'\n", RecordFile);
+        Result = 1;
     }
 
+    Debug.Destroy();
+    CameraBlock.Destroy();
+    ShutdownProfiler();
+    ShutdownWorld();
     glfwTerminate();
-    return 0;
+    return Result;
 }
@@ -1,15 +1,27 @@
 #ifndef __MAIN_H__
 #define __MAIN_H__
 
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
 #include "glm/glm.hpp"
 #include "chunkmanager.h"
+#include "raycast.h"
+#include "replay.h"
+#include "settings.h"
 #include "utils/common.h"
 #include "utils/shader.h"
 #include "utils/camera.h"
+#include "utils/debugdraw.h"
+#include "utils/profiler.h"
+#include "utils/uniformbuffer.h"
 
 typedef struct
 {
@@ -25,75 +37,133 @@ s32 WindowHeight = 720;
 static f32 dt = 0.0f;
 static u64 Tick = 0;
 static u8 CurrentHeldBlock = BlockType::GRASS;
+static bool MesherKeyHeld = false;
+static bool DiagnosticsKeyHeld = false;
+static bool ShowDiagnostics = false;
+static bool ProfileKeyHeld = false;
+static bool RadiusKeyHeld = false;
+static bool SettingsKeyHeld = false;
+static bool GovernorKeyHeld = false;
+static bool OcclusionKeyHeld = false;
+static const char* SettingsPath = SETTINGS_FILE;
 static Camera camera(glm::ivec3(0, 70, 0), glm::vec2(WindowWidth, WindowHeight));
 static RaycastInfo RaycastHit = {nullptr, nullptr, glm::ivec3(0), glm::ivec3(0)};
+static char StatusText[128] = ""; // Result of the Last One-Off Key, Shown in the Title & Overlay Until STATUS_SECONDS Pass
+static f64 StatusTime = 0.0;
+
+// Recording Appends Every Tick to ReplayPath, Replaying Plays it Back Instead of Reading Input
+static CameraPath ReplayPath;
+static bool Recording = false;
+static bool Replaying = false;
+static u32 ReplayWaitFrames = 0; // Frames the Current Replay Tick Has Been Held Back
+static ReplayResults Replay = {};
 
 #define MAX_REACH_DISTANCE 5.0f
+#define STATUS_SECONDS 5.0
 
+// Block Under the Crosshair & the Empty Block in Front of the Face Looked At, Positions are Local to Their Chunks
 RaycastInfo Raycast(const glm::vec3 Position, const glm::vec3 Direction)
 {
-    f32 CurrentReach = 0.0f;
-    glm::vec3 LastEmptyBlock = Position;
+    PROFILE_ZONE("Raycast");
 
-    while (CurrentReach < MAX_REACH_DISTANCE)
+    RayHit Hit;
+    if (!RaycastBlocks(Manager.Chunks, {Position, Direction, MAX_REACH_DISTANCE}, &Hit))
     {
-        CurrentReach += 0.01f;
-        glm::vec3 Result = Position + Direction * CurrentReach;
+        return {nullptr, nullptr, glm::ivec3(0), glm::ivec3(0)};
+    }
 
-		s32 ChunkX     = floor_(Result.x / CHUNK_SIZE);
-		s32 ChunkZ     = floor_(Result.z / CHUNK_SIZE);
-		s32 LastChunkX = floor_(LastEmptyBlock.x / CHUNK_SIZE);
-		s32 LastChunkZ = floor_(LastEmptyBlock.z / CHUNK_SIZE);
+    RaycastInfo Info = {Hit.HitChunk, nullptr, glm::ivec3(0), Hit.Block - Hit.HitChunk->Position * CHUNK_SIZE};
 
-        glm::ivec3 ChunkPosition(ChunkX, 0, ChunkZ);
-        glm::ivec3 LastChunkPosition(LastChunkX, 0, LastChunkZ);
-		if (Manager.Chunks.find(ChunkPosition) == Manager.Chunks.end() || Manager.Chunks.find(LastChunkPosition) == Manager.Chunks.end())
-		{
-			LastEmptyBlock = Result;
-			continue;
-		}
+    // Nothing to Place Against When the Camera Starts Inside a Block or the Face Looks Out of the World
+    glm::ivec3 Place = Hit.Block + Hit.Normal;
+    if (Hit.Normal != glm::ivec3(0) && Place.y >= 0 && Place.y < CHUNK_HEIGHT)
+    {
+        Info.RayChunk = GetChunk(glm::ivec3(GetBlockChunk(Place.x), 0, GetBlockChunk(Place.z)));
+        if (Info.RayChunk) Info.PlacePosition = Place - Info.RayChunk->Position * CHUNK_SIZE;
+    }
+    return Info;
+}
 
-		Chunk* LocalBlockChunk = Manager.Chunks[ChunkPosition];
-		Chunk* LastEmptyBlockChunk = Manager.Chunks[LastChunkPosition];
-
-		s32 LocalX = floor_(Result.x + BLOCK_RENDER_SIZE) - (ChunkX * CHUNK_SIZE);
-		s32 LocalY = floor_(Result.y + BLOCK_RENDER_SIZE);
-		s32 LocalZ = floor_(Result.z + BLOCK_RENDER_SIZE) - (ChunkZ * CHUNK_SIZE);
-		s32 LastEmptyLocalX = floor_(LastEmptyBlock.x + BLOCK_RENDER_SIZE) - (LastChunkX * CHUNK_SIZE);
-		s32 LastEmptyLocalY = floor_(LastEmptyBlock.y + BLOCK_RENDER_SIZE);
-		s32 LastEmptyLocalZ = floor_(LastEmptyBlock.z + BLOCK_RENDER_SIZE) - (LastChunkZ * CHUNK_SIZE);
-
-		clamp_(LocalX, 0, CHUNK_SIZE - 1);
-		clamp_(LocalY, 0, CHUNK_HEIGHT - 1);
-		clamp_(LocalZ, 0, CHUNK_SIZE - 1);
-		clamp_(LastEmptyLocalX, 0, CHUNK_SIZE - 1);
-		clamp_(LastEmptyLocalY, 0, CHUNK_HEIGHT - 1);
-		clamp_(LastEmptyLocalZ, 0, CHUNK_SIZE - 1);
-
-		// Enforce Height Limits 
-		if ((LastEmptyBlock.y <= 1 || LastEmptyBlock.y >= CHUNK_HEIGHT) || !LocalBlockChunk->Blocks[GetBlockIndex(LocalX, LocalY, LocalZ)])
-		{
-			LastEmptyBlock = Result;
-			continue;
-		}
+// Mesher, Radius & Culling Counters From the Last Frame Plus Any Fresh Status, Refreshed Periodically by the Main Loop
+void UpdateWindowTitle(GLFWwindow* Window)
+{
+    if (StatusText[0] && glfwGetTime() - StatusTime >= STATUS_SECONDS) StatusText[0] = '\0';
+
+    char Title[384];
+    snprintf(Title, sizeof(Title), "Too Many Voxels!%s | Radius %d of %d%s | Sections %u Drawn %u Culled (%u Occluded%s) | Triangles %lluk Drawn %lluk Culled%s%s",
+        Manager.Mesher == MeshingMode::GREEDY ? " (Greedy Meshing)" : "",
+        Manager.RenderDistance, Config.RenderDistance, Config.Governor ? " (Governed)" : "",
+        Manager.Stats.SectionsDrawn, Manager.Stats.SectionsCulled, Manager.Stats.SectionsOccluded, Manager.OcclusionCulling ? "" : ", Off",
+        Manager.Stats.TrianglesDrawn / 1000, Manager.Stats.TrianglesCulled / 1000,
+        StatusText[0] ? " | " : "", StatusText);
+    glfwSetWindowTitle(Window, Title);
+}
 
-        return {LocalBlockChunk, LastEmptyBlockChunk, glm::ivec3(LastEmptyLocalX, LastEmptyLocalY, LastEmptyLocalZ), glm::ivec3(LocalX, LocalY, LocalZ)};
+// Replaces the Status & Shows it Right Away Rather Than at the Next Periodic Title Refresh
+void SetStatus(GLFWwindow* Window, const char* Format, ...)
+{
+    va_list Args;
+    va_start(Args, Format);
+    vsnprintf(StatusText, sizeof(StatusText), Format, Args);
+    va_end(Args);
+
+    StatusTime = glfwGetTime();
+    UpdateWindowTitle(Window);
+}
+
+// Puts the Camera Where the Tick Recorded it & Applies the Tick's Edits, Returns False While the Tick is Held
+// Back Because a Chunk One of its Edits Touches Hasn't Generated Yet, so Edits Land the Same Way Every Run
+bool StepReplay(const PathTick& ReplayTick)
+{
+    camera.Position = ReplayTick.Position;
+    camera.FOV = ReplayTick.FOV;
+    camera.Look(ReplayTick.Yaw, ReplayTick.Pitch);
+
+    for (u32 i = 0; i < ReplayTick.EditCount && ReplayWaitFrames < REPLAY_EDIT_WAIT_FRAMES; ++i)
+    {
+        glm::ivec3 Block = ReplayPath.Edits[ReplayTick.FirstEdit + i].Block;
+        if (!GetChunk(glm::ivec3(GetBlockChunk(Block.x), 0, GetBlockChunk(Block.z))))
+        {
+            ReplayWaitFrames++;
+            Replay.WaitFrames++;
+            return false;
+        }
+    }
+
+    for (u32 i = 0; i < ReplayTick.EditCount; ++i)
+    {
+        const PathEdit& Edit = ReplayPath.Edits[ReplayTick.FirstEdit + i];
+        Chunk* chunk = GetChunk(glm::ivec3(GetBlockChunk(Edit.Block.x), 0, GetBlockChunk(Edit.Block.z)));
+        if (!chunk || Edit.Block.y < 0 || Edit.Block.y >= CHUNK_HEIGHT)
+        {
+            Replay.MissedEdits++;
+            continue;
+        }
+        SetBlock(chunk, Edit.Block - chunk->Position * CHUNK_SIZE, Edit.Type, Edit.Place);
     }
-    return {nullptr, nullptr, glm::ivec3(0), glm::ivec3(0)};
+
+    ReplayWaitFrames = 0;
+    return true;
 }
 
 void ProcessInput(GLFWwindow* Window)
 {
+    PROFILE_ZONE("ProcessInput");
+
     // Place / Break Voxel
     if (RaycastHit.CurrentChunk && Tick % 15 == 0)
     {
-		if (glfwGetMouseButton(Window, GLFW_MOUSE_BUTTON_1) == GLFW_PRESS)
+		if (RaycastHit.RayChunk && glfwGetMouseButton(Window, GLFW_MOUSE_BUTTON_1) == GLFW_PRESS)
 		{
 			SetBlock(RaycastHit.RayChunk, RaycastHit.PlacePosition, CurrentHeldBlock, true);
+			if (Recording) ReplayPath.RecordEdit(RaycastHit.PlacePosition + RaycastHit.RayChunk->Position * CHUNK_SIZE, CurrentHeldBlock, true);
 		}
-		if (glfwGetMouseButton(Window, GLFW_MOUSE_BUTTON_2) == GLFW_PRESS)
+		// Bedrock Floors the World, Breaking it Would Open a View Out the Bottom
+		const glm::ivec3 Break = RaycastHit.BreakPosition;
+		if (glfwGetMouseButton(Window, GLFW_MOUSE_BUTTON_2) == GLFW_PRESS && GetChunkBlock(RaycastHit.CurrentChunk, Break.x, Break.y, Break.z) != BlockType::BEDROCK)
 		{
 			SetBlock(RaycastHit.CurrentChunk, RaycastHit.BreakPosition, CurrentHeldBlock, false);
+			if (Recording) ReplayPath.RecordEdit(RaycastHit.BreakPosition + RaycastHit.CurrentChunk->Position * CHUNK_SIZE, CurrentHeldBlock, false);
 		}
     }
 
@@ -135,6 +205,116 @@ void ProcessInput(GLFWwindow* Window)
         camera.Position -= camera.Up * camera.Speed * dt;
     }
 
+    // Toggle Naive / Greedy Meshing
+    if (glfwGetKey(Window, GLFW_KEY_G) == GLFW_PRESS)
+    {
+        if (!MesherKeyHeld)
+        {
+            SetMeshingMode(Manager.Mesher == MeshingMode::GREEDY ? MeshingMode::NAIVE : MeshingMode::GREEDY);
+            UpdateWindowTitle(Window);
+        }
+        MesherKeyHeld = true;
+    }
+    else
+    {
+        MesherKeyHeld = false;
+    }
+
+    // Toggle Cave Occlusion Culling, Frustum Culling Stays On Either Way
+    if (glfwGetKey(Window, GLFW_KEY_O) == GLFW_PRESS)
+    {
+        if (!OcclusionKeyHeld)
+        {
+            Manager.OcclusionCulling = !Manager.OcclusionCulling;
+            UpdateWindowTitle(Window);
+        }
+        OcclusionKeyHeld = true;
+    }
+    else
+    {
+        OcclusionKeyHeld = false;
+    }
+
+    // Toggle Chunk Bounds & Counters Overlay
+    if (glfwGetKey(Window, GLFW_KEY_F3) == GLFW_PRESS)
+    {
+        if (!DiagnosticsKeyHeld)
+        {
+            ShowDiagnostics = !ShowDiagnostics;
+        }
+        DiagnosticsKeyHeld = true;
+    }
+    else
+    {
+        DiagnosticsKeyHeld = false;
+    }
+
+    // Dump Recent Zones & Frame Counters Next to the Executable
+    if (glfwGetKey(Window, GLFW_KEY_F4) == GLFW_PRESS)
+    {
+        if (!ProfileKeyHeld)
+        {
+            bool Dumped = DumpProfileTrace("profile.json") && DumpProfileCSV("profile.csv");
+            SetStatus(Window, Dumped ? "Wrote profile.json & profile.csv" : "Couldn't Write Profile");
+        }
+        ProfileKeyHeld = true;
+    }
+    else
+    {
+        ProfileKeyHeld = false;
+    }
+
+    // Step the Render Distance, Streams Just the Rings Gained or Lost
+    bool Nearer = glfwGetKey(Window, GLFW_KEY_MINUS) == GLFW_PRESS;
+    bool Farther = glfwGetKey(Window, GLFW_KEY_EQUAL) == GLFW_PRESS;
+    if (Nearer || Farther)
+    {
+        if (!RadiusKeyHeld)
+        {
+            Config.RenderDistance += Farther ? 4 : -4;
+            ClampSettings(&Config);
+            SetRenderDistance(Config.RenderDistance);
+            UpdateWindowTitle(Window);
+        }
+        RadiusKeyHeld = true;
+    }
+    else
+    {
+        RadiusKeyHeld = false;
+    }
+
+    // Reread the Settings File & Apply Whatever Changed
+    if (glfwGetKey(Window, GLFW_KEY_F5) == GLFW_PRESS)
+    {
+        if (!SettingsKeyHeld)
+        {
+            bool Loaded = LoadSettings(SettingsPath, &Config);
+            if (Loaded) ApplySettings();
+            SetStatus(Window, Loaded ? "Applied %s" : "Couldn't Read %s", SettingsPath);
+        }
+        SettingsKeyHeld = true;
+    }
+    else
+    {
+        SettingsKeyHeld = false;
+    }
+
+    // Toggle the Frame Time & Memory Governor, Turning it Off Restores the Configured Radius & Budget
+    if (glfwGetKey(Window, GLFW_KEY_F6) == GLFW_PRESS)
+    {
+        if (!GovernorKeyHeld)
+        {
+            Config.Governor = !Config.Governor;
+            if (!Config.Governor) ApplySettings();
+            UpdateWindowTitle(Window);
+        }
+        GovernorKeyHeld = true;
+    }
+    else
+    {
+        GovernorKeyHeld = false;
+    }
+
     // Close Window
     if(glfwGetKey(Window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
     {
@@ -191,52 +371,8 @@ void scroll_callback(GLFWwindow* Window, f64 XOffset, f64 YOffset)
 
 void RenderPlacementOutline(const Chunk* chunk, glm::ivec3 position)
 {
-	position += (chunk->Position * CHUNK_SIZE); 
-
-    glm::vec3 OutlineVertices[] = {
-        glm::vec3(position.x - BLOCK_RENDER_SIZE, position.y - BLOCK_RENDER_SIZE, position.z + BLOCK_RENDER_SIZE), 
-        glm::vec3(position.x + BLOCK_RENDER_SIZE, position.y - BLOCK_RENDER_SIZE, position.z + BLOCK_RENDER_SIZE), 
-        glm::vec3(position.x + BLOCK_RENDER_SIZE, position.y + BLOCK_RENDER_SIZE, position.z + BLOCK_RENDER_SIZE), 
-        glm::vec3(position.x - BLOCK_RENDER_SIZE, position.y + BLOCK_RENDER_SIZE, position.z + BLOCK_RENDER_SIZE), 
-        glm::vec3(position.x - BLOCK_RENDER_SIZE, position.y - BLOCK_RENDER_SIZE, position.z - BLOCK_RENDER_SIZE), 
-        glm::vec3(position.x + BLOCK_RENDER_SIZE, position.y - BLOCK_RENDER_SIZE, position.z - BLOCK_RENDER_SIZE), 
-        glm::vec3(position.x + BLOCK_RENDER_SIZE, position.y + BLOCK_RENDER_SIZE, position.z - BLOCK_RENDER_SIZE), 
-        glm::vec3(position.x - BLOCK_RENDER_SIZE, position.y + BLOCK_RENDER_SIZE, position.z - BLOCK_RENDER_SIZE)  
-    };
-
-    u32 Indices[] = {
-        0, 1, 1, 2, 
-        2, 3, 3, 0, 
-        4, 5, 5, 6, 
-        6, 7, 7, 4, 
-        0, 4, 1, 5, 
-        2, 6, 3, 7  
-    };
-
-    u32 VAO, VBO, EBO;
-    glGenVertexArrays(1, &VAO);
-    glBindVertexArray(VAO);
-
-    glGenBuffers(1, &VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, 8 * sizeof(glm::vec3), OutlineVertices, GL_STATIC_DRAW);
-
-    glGenBuffers(1, &EBO);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, 24 * sizeof(u32), Indices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(glm::vec3), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glDisable(GL_DEPTH_TEST);
-    glLineWidth(2.5);    
-    glDrawElements(GL_LINES, 24, GL_UNSIGNED_INT, 0);
-    glEnable(GL_DEPTH_TEST);
-
-    glBindVertexArray(0);
-    glDeleteVertexArrays(1, &VAO);
-    glDeleteBuffers(1, &VBO);
-    glDeleteBuffers(1, &EBO);
+	glm::vec3 Center = position + (chunk->Position * CHUNK_SIZE);
+	Debug.Box(Center - BLOCK_RENDER_SIZE, Center + BLOCK_RENDER_SIZE, glm::vec3(0.0f));
 }
 
 void RenderCrosshair()
@@ -244,32 +380,44 @@ void RenderCrosshair()
     f32 CenterX = WindowWidth / 2.0f;
     f32 CenterY = WindowHeight / 2.0f;
 
-	f32 CrosshairVertices[] =
-	{
-		CenterX - 7.0f, CenterY,
-		CenterX + 7.0f, CenterY,
-		CenterX,        CenterY - 7.0f,
-		CenterX,        CenterY + 7.0f,
-	};
-
-    u32 VAO, VBO;
-    glGenVertexArrays(1, &VAO);
-    glBindVertexArray(VAO);
-
-    glGenBuffers(1, &VBO);
-    glBindBuffer(GL_ARRAY_BUFFER, VBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(CrosshairVertices), CrosshairVertices, GL_STATIC_DRAW);
-
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(f32), (void*)0);
-    glEnableVertexAttribArray(0);
-
-    glLineWidth(2.5); 
-    glDrawArrays(GL_LINES, 0, 4);
-
-    glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-    glDeleteBuffers(1, &VBO);
-    glDeleteVertexArrays(1, &VAO);
+	Debug.ScreenLine(glm::vec2(CenterX - 7.0f, CenterY), glm::vec2(CenterX + 7.0f, CenterY), glm::vec3(0.0f));
+	Debug.ScreenLine(glm::vec2(CenterX, CenterY - 7.0f), glm::vec2(CenterX, CenterY + 7.0f), glm::vec3(0.0f));
+}
+
+// Bounds of Every Loaded Chunk's Sections, Colored by How Far Along They Are, Plus Counters in the Corner
+// Up to Date Sections Go From Green Through Blue as Their Level Coarsens, Orange Ones Have a Remesh in Flight, Unmeshed Chunks are Outlined Whole
+void RenderDiagnostics()
+{
+    static const glm::vec3 LodColors[LOD_COUNT] = {glm::vec3(0.0f, 1.0f, 0.0f), glm::vec3(0.0f, 1.0f, 1.0f), glm::vec3(0.0f, 0.4f, 1.0f), glm::vec3(0.6f, 0.2f, 1.0f)};
+
+    for (Chunk* chunk : Manager.Chunks.Cells)
+    {
+        if (!chunk) continue;
+
+        glm::vec3 Min(chunk->Position.x * CHUNK_SIZE - BLOCK_RENDER_SIZE, -BLOCK_RENDER_SIZE, chunk->Position.z * CHUNK_SIZE - BLOCK_RENDER_SIZE);
+        if (chunk->State != ChunkState::GENERATED || !chunk->MeshRevision)
+        {
+            glm::vec3 Color = chunk->State == ChunkState::GENERATED ? glm::vec3(1.0f, 0.0f, 0.0f) : glm::vec3(1.0f, 1.0f, 0.0f);
+            Debug.Box(Min, glm::vec3(Min.x + CHUNK_SIZE, CHUNK_HEIGHT - BLOCK_RENDER_SIZE, Min.z + CHUNK_SIZE), Color);
+            continue;
+        }
+
+        for (const SectionMesh& Section : chunk->Meshes)
+        {
+            if (!Section.IndexCount) continue;
+
+            glm::vec3 Color = Section.Uploaded == Section.Revision ? LodColors[chunk->Lod] : glm::vec3(1.0f, 0.5f, 0.0f);
+            Debug.Box(glm::vec3(Min.x, Section.MinY - BLOCK_RENDER_SIZE, Min.z), glm::vec3(Min.x + CHUNK_SIZE, Section.MaxY - BLOCK_RENDER_SIZE, Min.z + CHUNK_SIZE), Color);
+        }
+    }
+
+    char Text[384];
+    snprintf(Text, sizeof(Text), "%.1f MS GPU WORLD %.2f MS\nCHUNKS %zu RETAINED %zu\nRADIUS %d OF %d UPLOAD %u US%s\nSECTIONS %u DRAWN %u CULLED %u OCCLUDED%s\nDEBUG VERTICES %u DROPPED %u%s%s",
+        dt * 1000.0f, Profile.LastGpuWorldNs / 1e6, Manager.Chunks.Size(), Manager.Retained.size(),
+        Manager.RenderDistance, Config.RenderDistance, Manager.UploadBudgetUs, Config.Governor ? " GOVERNED" : "",
+        Manager.Stats.SectionsDrawn, Manager.Stats.SectionsCulled, Manager.Stats.SectionsOccluded, Manager.OcclusionCulling ? "" : " (OFF)",
+        Debug.LastVertices, Debug.LastDropped, StatusText[0] ? "\n" : "", StatusText);
+    Debug.Text(glm::vec2(8.0f, WindowHeight - 8.0f), Text, glm::vec3(1.0f));
 }
 
 #endif
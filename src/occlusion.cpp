@@ -0,0 +1,80 @@
+#include "occlusion.h"
+#include "raycast.h"
+
+// Step to the Neighboring Section Across Each BlockFace, Chunk Offsets in x & z, Section Offset in y
+static const glm::ivec3 FaceSteps[6] =
+{
+    glm::ivec3(0, 0, 1),
+    glm::ivec3(0, 0, -1),
+    glm::ivec3(1, 0, 0),
+    glm::ivec3(-1, 0, 0),
+    glm::ivec3(0, 1, 0),
+    glm::ivec3(0, -1, 0),
+};
+
+static inline bool SectionConnects(const Chunk* chunk, const SectionMesh& Section, const u8 a, const u8 b)
+{
+    // Nothing is Known Until the First Mesh Lands, Letting the Walk Through Keeps What's Behind it From Vanishing
+    if (chunk->State != ChunkState::GENERATED || !Section.Uploaded) return true;
+    return Section.Connectivity >> GetFacePairBit(a, b) & 1;
+}
+
+bool WalkVisibleSections(const ChunkGrid& Chunks, const Frustum& ViewFrustum, const glm::vec3& Eye, u32 Frame, std::vector<OcclusionStep>& Queue)
+{
+    // Blocks are Centered on Integer Coords, Shifting by Half a Block Puts Block i on [i, i + 1)
+    const glm::vec3 Start = Eye + BLOCK_RENDER_SIZE;
+    const glm::ivec3 Block(floor_(Start.x), floor_(Start.y), floor_(Start.z));
+    if (Block.y < 0 || Block.y >= CHUNK_HEIGHT) return false;
+
+    const glm::ivec3 First(GetBlockChunk(Block.x), Block.y / SECTION_SIZE, GetBlockChunk(Block.z));
+    Chunk* FirstChunk = Chunks.Find(glm::ivec3(First.x, 0, First.z));
+    if (!FirstChunk) return false;
+
+    SectionMesh& FirstSection = FirstChunk->Meshes[First.y];
+    FirstSection.VisibleFrame = Frame;
+    FirstSection.EnteredFaces = 0x3F;
+
+    Queue.clear();
+    Queue.push_back({First, OCCLUSION_START, 0});
+
+    for (size_t Head = 0; Head < Queue.size(); ++Head)
+    {
+        const OcclusionStep Step = Queue[Head];
+        Chunk* Current = Chunks.Find(glm::ivec3(Step.Section.x, 0, Step.Section.z));
+        const SectionMesh& Section = Current->Meshes[Step.Section.y];
+
+        for (u8 Face = 0; Face < 6; ++Face)
+        {
+            // Turning Back Can Only Reach What a Straighter Path Already Could
+            if (Step.Traveled & (1 << (Face ^ 1))) continue;
+            if (Step.Entered != OCCLUSION_START && !SectionConnects(Current, Section, Step.Entered, Face)) continue;
+
+            const glm::ivec3 Next = Step.Section + FaceSteps[Face];
+            if (Next.y < 0 || Next.y >= SECTION_COUNT) continue;
+
+            Chunk* NextChunk = Face < BlockFace::TOP ? Chunks.Find(glm::ivec3(Next.x, 0, Next.z)) : Current;
+            if (!NextChunk) continue;
+
+            // Neighbor is Entered Through its Face Opposite the Step
+            const u8 Entered = Face ^ 1;
+            SectionMesh& Target = NextChunk->Meshes[Next.y];
+            if (Target.VisibleFrame == Frame)
+            {
+                if (Target.EnteredFaces & (1 << Entered)) continue;
+            }
+            else
+            {
+                // Whole Section Box, Air Outside the Mesh's Height Range Still Leads Somewhere
+                glm::vec3 Min(Next.x * CHUNK_SIZE - BLOCK_RENDER_SIZE, Next.y * SECTION_SIZE - BLOCK_RENDER_SIZE, Next.z * CHUNK_SIZE - BLOCK_RENDER_SIZE);
+                if (!ViewFrustum.Touches(Min, Min + (f32)SECTION_SIZE)) continue;
+
+                Target.VisibleFrame = Frame;
+                Target.EnteredFaces = 0;
+            }
+
+            Target.EnteredFaces |= 1 << Entered;
+            Queue.push_back({Next, Entered, (u8)(Step.Traveled | (1 << Face))});
+        }
+    }
+    return true;
+}
@@ -0,0 +1,27 @@
+#ifndef __OCCLUSION_H__
+#define __OCCLUSION_H__
+
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "utils/common.h"
+#include "utils/frustum.h"
+#include "chunk.h"
+#include "chunkgrid.h"
+
+#define OCCLUSION_START 6 // Entered Face of the Camera's Own Section, Which Sees Out Every Side
+
+typedef struct
+{
+    glm::ivec3 Section; // Chunk x, Section Index, Chunk z
+    u8 Entered; // BlockFace of the Section the Walk Came in Through
+    u8 Traveled; // Bit per BlockFace Direction Stepped Along to Get Here
+} OcclusionStep;
+
+// Breadth First From the Camera's Section, Stepping Only Between Faces a Section's Air Joins Up & Never Back Against a
+// Direction Already Taken, so Sections Sealed Off Behind Solid Ground Stay Unvisited. Reached Sections Get VisibleFrame = Frame
+// Sections Without an Uploaded Mesh Count as Open. Returns False Without Marking Anything When the Camera is Above or
+// Below the Column or its Chunk Isn't Loaded, Everything in the Frustum Should be Drawn Then
+bool WalkVisibleSections(const ChunkGrid& Chunks, const Frustum& ViewFrustum, const glm::vec3& Eye, u32 Frame, std::vector<OcclusionStep>& Queue);
+
+#endif
@@ -0,0 +1,93 @@
+#include <cfloat>
+#include <climits>
+
+#include "raycast.h"
+
+// Walks the Grid From Cached, Which is Updated Whenever the Ray Crosses Into Another Chunk
+static bool TraverseBlocks(const ChunkGrid& Chunks, const Ray& ray, RayHit* Hit, Chunk*& Cached, glm::ivec3& CachedPosition)
+{
+    *Hit = {false, nullptr, glm::ivec3(0), glm::ivec3(0), 0.0f};
+
+    // Blocks are Centered on Integer Coords, Shifting by Half a Block Puts Block i on [i, i + 1)
+    const glm::vec3 Start = ray.Origin + BLOCK_RENDER_SIZE;
+    glm::ivec3 Block(floor_(Start.x), floor_(Start.y), floor_(Start.z));
+
+    glm::ivec3 Step;
+    glm::vec3 NextBoundary; // Ray Distance to the Next Block Face on Each Axis
+    glm::vec3 BoundaryStep; // Ray Distance Between Consecutive Faces on Each Axis
+    for (u8 Axis = 0; Axis < 3; ++Axis)
+    {
+        const f32 Direction = ray.Direction[Axis];
+        if (Direction > 0.0f)
+        {
+            Step[Axis] = 1;
+            BoundaryStep[Axis] = 1.0f / Direction;
+            NextBoundary[Axis] = (Block[Axis] + 1 - Start[Axis]) * BoundaryStep[Axis];
+        }
+        else if (Direction < 0.0f)
+        {
+            Step[Axis] = -1;
+            BoundaryStep[Axis] = -1.0f / Direction;
+            NextBoundary[Axis] = (Start[Axis] - Block[Axis]) * BoundaryStep[Axis];
+        }
+        else
+        {
+            Step[Axis] = 0;
+            BoundaryStep[Axis] = FLT_MAX;
+            NextBoundary[Axis] = FLT_MAX;
+        }
+    }
+
+    glm::ivec3 Normal(0);
+    f32 Distance = 0.0f;
+    while (Distance <= ray.MaxDistance)
+    {
+        if (Block.y >= 0 && Block.y < CHUNK_HEIGHT)
+        {
+            glm::ivec3 ChunkPosition(GetBlockChunk(Block.x), 0, GetBlockChunk(Block.z));
+            if (ChunkPosition != CachedPosition)
+            {
+                Cached = Chunks.Find(ChunkPosition);
+                if (Cached && Cached->State != ChunkState::GENERATED) Cached = nullptr;
+                CachedPosition = ChunkPosition;
+            }
+
+            if (Cached && GetChunkBlock(Cached, Block.x - ChunkPosition.x * CHUNK_SIZE, Block.y, Block.z - ChunkPosition.z * CHUNK_SIZE) != BlockType::AIR)
+            {
+                *Hit = {true, Cached, Block, Normal, Distance};
+                return true;
+            }
+        }
+        else if ((Block.y < 0 && Step.y <= 0) || (Block.y >= CHUNK_HEIGHT && Step.y >= 0))
+        {
+            // Outside the World's Height Range & Never Coming Back
+            return false;
+        }
+
+        // Cross Whichever Face is Nearest, the Face's Normal Points Back Along the Step
+        u8 Axis = NextBoundary.x < NextBoundary.y ? (NextBoundary.x < NextBoundary.z ? 0 : 2) : (NextBoundary.y < NextBoundary.z ? 1 : 2);
+        Distance = NextBoundary[Axis];
+        NextBoundary[Axis] += BoundaryStep[Axis];
+        Block[Axis] += Step[Axis];
+        Normal = glm::ivec3(0);
+        Normal[Axis] = -Step[Axis];
+    }
+    return false;
+}
+
+bool RaycastBlocks(const ChunkGrid& Chunks, const Ray& ray, RayHit* Hit)
+{
+    Chunk* Cached = nullptr;
+    glm::ivec3 CachedPosition(INT_MIN);
+    return TraverseBlocks(Chunks, ray, Hit, Cached, CachedPosition);
+}
+
+void RaycastBlocks(const ChunkGrid& Chunks, const Ray* Rays, RayHit* Hits, u32 Count)
+{
+    Chunk* Cached = nullptr;
+    glm::ivec3 CachedPosition(INT_MIN);
+    for (u32 i = 0; i < Count; ++i)
+    {
+        TraverseBlocks(Chunks, Rays[i], &Hits[i], Cached, CachedPosition);
+    }
+}
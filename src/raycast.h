@@ -0,0 +1,38 @@
+#ifndef __RAYCAST_H__
+#define __RAYCAST_H__
+
+#include "glm/glm.hpp"
+#include "utils/common.h"
+#include "chunk.h"
+#include "chunkgrid.h"
+
+typedef struct
+{
+    glm::vec3 Origin;
+    glm::vec3 Direction; // Needn't be Normalized, Distances are in Units of its Length
+    f32 MaxDistance;
+} Ray;
+
+typedef struct
+{
+    bool Hit;
+    Chunk* HitChunk; // Chunk Holding Block
+    glm::ivec3 Block; // World Block Coordinates of the First Solid Block
+    glm::ivec3 Normal; // Face the Ray Entered Through, Zero When it Started Inside Block
+    f32 Distance;
+} RayHit;
+
+// Visits Every Block the Ray Passes Through Exactly Once (Amanatides & Woo), Nearest First
+// Only Generated Chunks are Tested, Blocks in Missing or Generating Chunks Count as Air
+bool RaycastBlocks(const ChunkGrid& Chunks, const Ray& ray, RayHit* Hit);
+
+// Same as Above for Many Rays, the Chunk Last Looked Up Carries Over From One Ray to the Next
+void RaycastBlocks(const ChunkGrid& Chunks, const Ray* Rays, RayHit* Hits, u32 Count);
+
+// Chunk Holding a World Block Coordinate, Rounds Toward Negative Infinity
+inline s32 GetBlockChunk(const s32 Block)
+{
+    return Block >= 0 ? Block / CHUNK_SIZE : (Block + 1) / CHUNK_SIZE - 1;
+}
+
+#endif
@@ -0,0 +1,412 @@
+#include <cstring>
+#include <filesystem>
+
+#ifndef _WIN32
+#include <sys/mman.h>
+#endif
+
+#include "region.h"
+
+bool RegionFile::Open(const char* Path)
+{
+    File = fopen(Path, "r+b");
+    if (!File)
+    {
+        // New Region, Every Header Entry Starts Empty
+        File = fopen(Path, "w+b");
+        if (!File) return false;
+
+        memset(Header, 0, sizeof(Header));
+        fwrite(Header, sizeof(Header), 1, File);
+        fflush(File);
+    }
+    else if (fread(Header, sizeof(Header), 1, File) != 1)
+    {
+        fclose(File);
+        File = nullptr;
+        return false;
+    }
+
+    fseek(File, 0, SEEK_END);
+    FileSize = (u32)ftell(File);
+    return true;
+}
+
+void RegionFile::Close()
+{
+#ifndef _WIN32
+    if (Mapping) munmap(Mapping, MappedSize);
+#endif
+    Mapping = nullptr;
+    MappedSize = 0;
+
+    if (File) fclose(File);
+    File = nullptr;
+}
+
+// Returned Pointer is Valid Until the Next Read or Write
+const u8* RegionFile::Read(u16 Index, u32* Size)
+{
+    const RegionEntry& Entry = Header[Index];
+    if (!Entry.Size) return nullptr;
+    *Size = Entry.Size;
+
+#ifndef _WIN32
+    // Mapping Covers the File as it Was When Mapped, Remapped Once Appends Outgrow It
+    if (Entry.Offset + Entry.Size > MappedSize)
+    {
+        if (Mapping) munmap(Mapping, MappedSize);
+
+        void* Mapped = mmap(nullptr, FileSize, PROT_READ, MAP_SHARED, fileno(File), 0);
+        Mapping = Mapped == MAP_FAILED ? nullptr : (u8*)Mapped;
+        MappedSize = Mapping ? FileSize : 0;
+    }
+    if (Mapping) return Mapping + Entry.Offset;
+#endif
+
+    ReadBuffer.resize(Entry.Size);
+    fseek(File, Entry.Offset, SEEK_SET);
+    if (fread(ReadBuffer.data(), Entry.Size, 1, File) != 1) return nullptr;
+    return ReadBuffer.data();
+}
+
+// Rewrites in Place When the Payload Still Fits its Slot, Otherwise Appends a Bigger Slot
+bool RegionFile::Write(u16 Index, const std::vector<u8>& Payload)
+{
+    RegionEntry& Entry = Header[Index];
+    const u32 Size = (u32)Payload.size();
+
+    bool Append = Size > Entry.Capacity;
+    if (Append)
+    {
+        Entry.Offset = FileSize;
+        Entry.Capacity = (Size + REGION_PAYLOAD_ALIGN - 1) / REGION_PAYLOAD_ALIGN * REGION_PAYLOAD_ALIGN;
+    }
+    Entry.Size = Size;
+
+    fseek(File, Entry.Offset, SEEK_SET);
+    if (fwrite(Payload.data(), Size, 1, File) != 1) return false;
+
+    // Slot is Padded Out so the File Never Ends Short of a Mapped Length
+    if (Append)
+    {
+        static const u8 Zeros[REGION_PAYLOAD_ALIGN] = {};
+        fwrite(Zeros, Entry.Capacity - Size, 1, File);
+        FileSize += Entry.Capacity;
+    }
+
+    fseek(File, Index * sizeof(RegionEntry), SEEK_SET);
+    fwrite(&Entry, sizeof(RegionEntry), 1, File);
+    fflush(File);
+    return true;
+}
+
+void RegionStore::Start(const char* WorldDirectory)
+{
+    Directory = WorldDirectory;
+    std::error_code Error;
+    std::filesystem::create_directories(Directory, Error);
+
+    Requests.resize(REGION_QUEUE_CAPACITY);
+    Head = Tail = 0;
+
+    Running = true;
+    Thread = std::thread(&RegionStore::IOLoop, this);
+}
+
+void RegionStore::Stop()
+{
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        Running = false;
+
+        for (u64 Sequence = Head; Sequence < Tail; ++Sequence)
+        {
+            RegionRequest& Request = Requests[Sequence & (Requests.size() - 1)];
+            if (Request.Type == RegionRequestType::LOAD) Request.Target = nullptr;
+        }
+    }
+    RequestAvailable.notify_all();
+    Thread.join();
+
+    for (auto& [Position, Region] : Regions)
+    {
+        Region->Close();
+        delete Region;
+    }
+    Regions.clear();
+    MissingRegions.clear();
+}
+
+// Caller Holds Mutex, Entries Keep Their Sequence Numbers When the Ring Doubles
+void RegionStore::Enqueue(RegionRequest&& Request)
+{
+    if (Tail - Head == Requests.size())
+    {
+        std::vector<RegionRequest> Grown(Requests.size() * 2);
+        for (u64 Sequence = Head; Sequence < Tail; ++Sequence)
+        {
+            Grown[Sequence & (Grown.size() - 1)] = std::move(Requests[Sequence & (Requests.size() - 1)]);
+        }
+        Requests.swap(Grown);
+    }
+    Requests[Tail++ & (Requests.size() - 1)] = std::move(Request);
+}
+
+u64 RegionStore::Load(Chunk* chunk, std::function<void()> Loaded, std::function<void()> Missing)
+{
+    u64 Ticket;
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        Enqueue({RegionRequestType::LOAD, chunk->Position, chunk, std::move(Loaded), std::move(Missing), {}});
+        Ticket = Tail; // Sequence + 1
+    }
+    RequestAvailable.notify_one();
+    return Ticket;
+}
+
+// Serializing is a Plain Copy of the Packed Sections, Compression & Disk Writes Happen on the I/O Thread
+void RegionStore::Save(const Chunk* chunk)
+{
+    RegionRequest Request = {RegionRequestType::SAVE, chunk->Position, nullptr, nullptr, nullptr, {}};
+    SerializeChunk(chunk, Request.Payload);
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        Enqueue(std::move(Request));
+    }
+    RequestAvailable.notify_one();
+}
+
+// Leaves the Request in Place With No Target, the I/O Thread Skips it When it Comes Up
+bool RegionStore::CancelLoad(u64 Ticket)
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    if (!Ticket || Ticket - 1 < Head) return false;
+
+    RegionRequest& Request = Requests[(Ticket - 1) & (Requests.size() - 1)];
+    if (!Request.Target) return false;
+
+    Request.Target = nullptr;
+    return true;
+}
+
+void RegionStore::IOLoop()
+{
+    std::vector<u8> Compressed;
+
+    while (true)
+    {
+        RegionRequest Request;
+        {
+            std::unique_lock<std::mutex> Lock(Mutex);
+            RequestAvailable.wait(Lock, [this] { return !Running || Head < Tail; });
+            if (Head == Tail) return;
+
+            // Moving Out Leaves the Slot's Payload & Callbacks Empty, Ready for Reuse
+            Request = std::move(Requests[Head++ & (Requests.size() - 1)]);
+        }
+
+        // Cancelled Loads Keep Their Place in the Ring Until Reached, Their Callbacks Go With Them Here
+        if (Request.Type == RegionRequestType::LOAD && !Request.Target) continue;
+
+        if (Request.Type == RegionRequestType::SAVE)
+        {
+            PROFILE_ZONE("SaveChunk");
+            CompressPayload(Request.Payload, Compressed);
+            if (RegionFile* Region = GetRegion(GetRegionPosition(Request.Position), true))
+            {
+                Region->Write(GetRegionIndex(Request.Position), Compressed);
+            }
+            continue;
+        }
+
+        // Never Saved (or Unreadable) Chunks Fall Back to Generation
+        PROFILE_ZONE("LoadChunk");
+        RegionFile* Region = GetRegion(GetRegionPosition(Request.Position), false);
+        u32 Size = 0;
+        const u8* Data = Region ? Region->Read(GetRegionIndex(Request.Position), &Size) : nullptr;
+
+        if (Data && DecompressPayload(Data, Size, Scratch) && DeserializeChunk(Scratch.data(), Scratch.size(), Request.Target))
+        {
+            Request.Loaded();
+        }
+        else
+        {
+            Request.Missing();
+        }
+    }
+}
+
+// Loads Don't Create Files, Regions Nobody Has Saved to Stay Off Disk
+// A Missing Region is Only Looked for Once, Every Later Load in it Goes Straight to Missing Without Touching the Disk
+RegionFile* RegionStore::GetRegion(glm::ivec2 Region, bool Create)
+{
+    auto it = Regions.find(Region);
+    if (it != Regions.end())
+    {
+        it->second->LastUsed = ++UseCount;
+        return it->second;
+    }
+    if (!Create && MissingRegions.count(Region)) return nullptr;
+
+    std::string Path = Directory + "/r." + std::to_string(Region.x) + "." + std::to_string(Region.y) + ".bin";
+    if (!Create && !std::filesystem::exists(Path))
+    {
+        MissingRegions.insert(Region);
+        return nullptr;
+    }
+    MissingRegions.erase(Region);
+
+    RegionFile* File = new RegionFile;
+    if (!File->Open(Path.c_str()))
+    {
+        delete File;
+        return nullptr;
+    }
+
+    // Least Recently Used Goes, the Cache is Small Enough That Scanning it Beats Keeping an Order
+    if (Regions.size() >= REGION_CACHE_SIZE)
+    {
+        auto Oldest = Regions.begin();
+        for (auto Open = Regions.begin(); Open != Regions.end(); ++Open)
+        {
+            if (Open->second->LastUsed < Oldest->second->LastUsed) Oldest = Open;
+        }
+        Oldest->second->Close();
+        delete Oldest->second;
+        Regions.erase(Oldest);
+    }
+    File->LastUsed = ++UseCount;
+    Regions[Region] = File;
+    return File;
+}
+
+// Version, Then per Section: Bits, Value, Palette Size (u16), Palette, Packed Index Words
+void SerializeChunk(const Chunk* chunk, std::vector<u8>& Out)
+{
+    Out.clear();
+    Out.push_back(CHUNK_FORMAT_VERSION);
+
+    for (const BlockSection& Section : chunk->Sections)
+    {
+        u16 PaletteSize = (u16)Section.Palette.size();
+        size_t DataBytes = Section.Data.size() * sizeof(u64);
+
+        size_t Start = Out.size();
+        Out.resize(Start + 4 + PaletteSize + DataBytes);
+        u8* Write = &Out[Start];
+
+        Write[0] = Section.Bits;
+        Write[1] = Section.Value;
+        memcpy(Write + 2, &PaletteSize, sizeof(u16));
+        if (PaletteSize) memcpy(Write + 4, Section.Palette.data(), PaletteSize);
+        if (DataBytes) memcpy(Write + 4 + PaletteSize, Section.Data.data(), DataBytes);
+    }
+}
+
+bool DeserializeChunk(const u8* Data, size_t Size, Chunk* chunk)
+{
+    if (!Size || Data[0] != CHUNK_FORMAT_VERSION) return false;
+
+    size_t Read = 1;
+    for (BlockSection& Section : chunk->Sections)
+    {
+        if (Read + 4 > Size) return false;
+
+        u8 Bits = Data[Read];
+        u16 PaletteSize;
+        memcpy(&PaletteSize, Data + Read + 2, sizeof(u16));
+        if (Bits != 0 && Bits != 1 && Bits != 2 && Bits != 4 && Bits != 8) return false;
+        if (Bits && (PaletteSize == 0 || PaletteSize > (1u << Bits))) return false;
+
+        size_t DataBytes = SECTION_VOLUME * Bits / 8;
+        if (Read + 4 + PaletteSize + DataBytes > Size) return false;
+
+        Section.Bits = Bits;
+        Section.Value = Data[Read + 1];
+        Section.Palette.assign(Data + Read + 4, Data + Read + 4 + PaletteSize);
+        if (Bits) SizeSectionData(&Section, Bits);
+        else ReleaseSectionData(&Section);
+        if (DataBytes) memcpy(Section.Data.data(), Data + Read + 4 + PaletteSize, DataBytes);
+
+        // Indices Past the Palette Would Read Off its End in GetSectionBlock, Only Possible When it Isn't Full
+        if (Bits && PaletteSize < (1u << Bits))
+        {
+            const u64 Mask = (1ull << Bits) - 1;
+            for (u32 Bit = 0; Bit < SECTION_VOLUME * Bits; Bit += Bits)
+            {
+                if ((Section.Data[Bit >> 6] >> (Bit & 63) & Mask) >= PaletteSize) return false;
+            }
+        }
+
+        Read += 4 + PaletteSize + DataBytes;
+    }
+    return true;
+}
+
+// Byte Run-Length Coding After a u32 Raw Size: Control 0-127 Copies Control + 1 Literal Bytes,
+// 128-255 Repeats the Next Byte Control - 125 Times. Packed Sections are Mostly Long Zero Runs
+void CompressPayload(const std::vector<u8>& Raw, std::vector<u8>& Out)
+{
+    const size_t Count = Raw.size();
+    Out.resize(sizeof(u32));
+    u32 RawSize = (u32)Count;
+    memcpy(Out.data(), &RawSize, sizeof(u32));
+
+    size_t i = 0;
+    while (i < Count)
+    {
+        size_t Run = 1;
+        while (i + Run < Count && Run < 130 && Raw[i + Run] == Raw[i]) Run++;
+
+        if (Run >= 3)
+        {
+            Out.push_back((u8)(Run + 125));
+            Out.push_back(Raw[i]);
+            i += Run;
+            continue;
+        }
+
+        // Literals Stop Where the Next Run of Three Begins
+        size_t Start = i;
+        while (i < Count && i - Start < 128)
+        {
+            if (i + 2 < Count && Raw[i] == Raw[i + 1] && Raw[i] == Raw[i + 2]) break;
+            i++;
+        }
+        Out.push_back((u8)(i - Start - 1));
+        Out.insert(Out.end(), Raw.begin() + Start, Raw.begin() + i);
+    }
+}
+
+bool DecompressPayload(const u8* Data, size_t Size, std::vector<u8>& Out)
+{
+    if (Size < sizeof(u32)) return false;
+
+    u32 RawSize;
+    memcpy(&RawSize, Data, sizeof(u32));
+    Out.resize(RawSize);
+
+    size_t Read = sizeof(u32);
+    size_t Written = 0;
+    while (Read < Size && Written < RawSize)
+    {
+        u8 Control = Data[Read++];
+        if (Control < 128)
+        {
+            size_t Length = Control + 1;
+            if (Read + Length > Size || Written + Length > RawSize) return false;
+            memcpy(&Out[Written], Data + Read, Length);
+            Read += Length;
+            Written += Length;
+        }
+        else
+        {
+            size_t Length = Control - 125;
+            if (Read >= Size || Written + Length > RawSize) return false;
+            memset(&Out[Written], Data[Read++], Length);
+            Written += Length;
+        }
+    }
+    return Written == RawSize;
+}
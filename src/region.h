@@ -0,0 +1,128 @@
+#ifndef __REGION_H__
+#define __REGION_H__
+
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "utils/common.h"
+#include "chunk.h"
+
+#define WORLD_DIRECTORY "world"
+#define REGION_SIZE 32 // Chunks per Region Side
+#define REGION_CHUNKS (REGION_SIZE * REGION_SIZE)
+#define REGION_PAYLOAD_ALIGN 512 // Payload Slots are Rounded Up so Small Growth Rewrites in Place
+#define REGION_CACHE_SIZE 16 // Region Files Kept Open by the I/O Thread
+#define REGION_QUEUE_CAPACITY 1024 // Starting Request Ring Size, Doubled Whenever it Fills
+#define CHUNK_FORMAT_VERSION 1
+
+// Header Entry per Chunk, Size of 0 Means Never Saved
+typedef struct
+{
+    u32 Offset;
+    u32 Size;
+    u32 Capacity;
+} RegionEntry;
+
+// 32x32 Chunks in One File: Offset Table Followed by Compressed Payloads
+// Reads Come Straight From a Memory Mapping Where the Platform Has One
+struct RegionFile
+{
+    bool Open(const char* Path);
+    void Close();
+
+    const u8* Read(u16 Index, u32* Size);
+    bool Write(u16 Index, const std::vector<u8>& Payload);
+
+    FILE* File = nullptr;
+    RegionEntry Header[REGION_CHUNKS];
+    u32 FileSize = 0;
+    u8* Mapping = nullptr;
+    size_t MappedSize = 0;
+    u64 LastUsed = 0; // RegionStore::UseCount at its Latest Lookup, the Lowest is Closed First
+    std::vector<u8> ReadBuffer; // Used When Memory Mapping Isn't Available
+};
+
+enum RegionRequestType
+{
+    LOAD = 0,
+    SAVE = 1,
+};
+
+typedef struct
+{
+    u8 Type;
+    glm::ivec3 Position;
+    Chunk* Target; // Loads Fill Target's Sections, Then Run Loaded or Missing, Null Once the Load is Cancelled
+    std::function<void()> Loaded;
+    std::function<void()> Missing;
+    std::vector<u8> Payload; // Saves Carry the Serialized Chunk, Compressed on the I/O Thread
+} RegionRequest;
+
+typedef struct
+{
+    size_t operator()(const glm::ivec2& pos) const
+    {
+        return std::hash<int>()(pos.x) ^ (std::hash<int>()(pos.y) << 1);
+    }
+} RegionHash;
+
+// Background Thread Owning Every Region File, Requests Run in Submission Order
+// so a Load Queued After a Save of the Same Chunk Always Sees the Saved Blocks
+struct RegionStore
+{
+    void Start(const char* Directory);
+    void Stop(); // Finishes Every Queued Save, Queued Loads are Dropped
+
+    // Returns a Ticket for CancelLoad, Never 0
+    u64 Load(Chunk* chunk, std::function<void()> Loaded, std::function<void()> Missing);
+    void Save(const Chunk* chunk);
+    bool CancelLoad(u64 Ticket); // Returns False if the Load Already Started
+
+    std::mutex Mutex;
+    std::condition_variable RequestAvailable;
+
+    // Ring Indexed by Sequence Number & (Size - 1), Sequences [Head, Tail) are Queued
+    // Queuing Only Allocates When the Ring Has to Grow, Cancelling Just Clears the Request's Target
+    std::vector<RegionRequest> Requests;
+    u64 Head = 0;
+    u64 Tail = 0;
+    std::thread Thread;
+    bool Running = false;
+
+    // Only Touched by the I/O Thread
+    std::string Directory;
+    std::unordered_map<glm::ivec2, RegionFile*, RegionHash> Regions;
+    u64 UseCount = 0;
+    std::unordered_set<glm::ivec2, RegionHash> MissingRegions; // Looked for & Not on Disk, Forgotten When a Save Creates One
+    std::vector<u8> Scratch;
+
+private:
+    void IOLoop();
+    void Enqueue(RegionRequest&& Request);
+    RegionFile* GetRegion(glm::ivec2 Region, bool Create);
+};
+
+void SerializeChunk(const Chunk* chunk, std::vector<u8>& Out);
+bool DeserializeChunk(const u8* Data, size_t Size, Chunk* chunk);
+void CompressPayload(const std::vector<u8>& Raw, std::vector<u8>& Out);
+bool DecompressPayload(const u8* Data, size_t Size, std::vector<u8>& Out);
+
+inline glm::ivec2 GetRegionPosition(glm::ivec3 ChunkPosition)
+{
+    return glm::ivec2(ChunkPosition.x >> 5, ChunkPosition.z >> 5);
+}
+
+inline u16 GetRegionIndex(glm::ivec3 ChunkPosition)
+{
+    return (ChunkPosition.x & (REGION_SIZE - 1)) + (ChunkPosition.z & (REGION_SIZE - 1)) * REGION_SIZE;
+}
+
+#endif
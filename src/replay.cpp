@@ -0,0 +1,207 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "block.h"
+#include "replay.h"
+
+template <typename T>
+static inline void Append(std::vector<u8>& Out, const T& Value)
+{
+    size_t Start = Out.size();
+    Out.resize(Start + sizeof(T));
+    memcpy(&Out[Start], &Value, sizeof(T));
+}
+
+template <typename T>
+static inline bool Take(const std::vector<u8>& In, size_t& Read, T* Value)
+{
+    if (Read + sizeof(T) > In.size()) return false;
+    memcpy(Value, &In[Read], sizeof(T));
+    Read += sizeof(T);
+    return true;
+}
+
+bool CameraPath::Save(const char* Path) const
+{
+    std::vector<u8> Out;
+    Out.reserve(16 + Ticks.size() * 26 + Edits.size() * 14);
+
+    Append(Out, (u32)REPLAY_MAGIC);
+    Append(Out, (u16)REPLAY_VERSION);
+    Append(Out, (u16)TickRate);
+    Append(Out, (u32)Ticks.size());
+    Append(Out, (u32)Edits.size());
+
+    for (const PathTick& Tick : Ticks)
+    {
+        Append(Out, Tick.Position.x);
+        Append(Out, Tick.Position.y);
+        Append(Out, Tick.Position.z);
+        Append(Out, Tick.Yaw);
+        Append(Out, Tick.Pitch);
+        Append(Out, Tick.FOV);
+        Append(Out, Tick.EditCount);
+    }
+    for (const PathEdit& Edit : Edits)
+    {
+        Append(Out, Edit.Block.x);
+        Append(Out, Edit.Block.y);
+        Append(Out, Edit.Block.z);
+        Append(Out, Edit.Type);
+        Append(Out, Edit.Place);
+    }
+
+    FILE* File = fopen(Path, "wb");
+    if (!File) return false;
+    bool Written = fwrite(Out.data(), 1, Out.size(), File) == Out.size();
+    return fclose(File) == 0 && Written;
+}
+
+bool CameraPath::Load(const char* Path)
+{
+    Clear();
+
+    FILE* File = fopen(Path, "rb");
+    if (!File) return false;
+
+    std::vector<u8> In;
+    u8 Buffer[4096];
+    size_t Count;
+    while ((Count = fread(Buffer, 1, sizeof(Buffer), File)) > 0)
+    {
+        In.insert(In.end(), Buffer, Buffer + Count);
+    }
+    fclose(File);
+
+    size_t Read = 0;
+    u32 Magic, TickCount, EditCount;
+    u16 Version, Rate;
+    if (!Take(In, Read, &Magic) || !Take(In, Read, &Version) || !Take(In, Read, &Rate) || !Take(In, Read, &TickCount) || !Take(In, Read, &EditCount)) return false;
+    if (Magic != REPLAY_MAGIC || Version != REPLAY_VERSION || !Rate) return false;
+    if (In.size() - Read != (size_t)TickCount * 26 + (size_t)EditCount * 14) return false;
+
+    TickRate = Rate;
+    Ticks.resize(TickCount);
+    Edits.resize(EditCount);
+
+    u32 FirstEdit = 0;
+    for (PathTick& Tick : Ticks)
+    {
+        Take(In, Read, &Tick.Position.x);
+        Take(In, Read, &Tick.Position.y);
+        Take(In, Read, &Tick.Position.z);
+        Take(In, Read, &Tick.Yaw);
+        Take(In, Read, &Tick.Pitch);
+        Take(In, Read, &Tick.FOV);
+        Take(In, Read, &Tick.EditCount);
+        Tick.FirstEdit = FirstEdit;
+        FirstEdit += Tick.EditCount;
+    }
+    if (FirstEdit != EditCount)
+    {
+        Clear();
+        return false;
+    }
+
+    for (PathEdit& Edit : Edits)
+    {
+        Take(In, Read, &Edit.Block.x);
+        Take(In, Read, &Edit.Block.y);
+        Take(In, Read, &Edit.Block.z);
+        Take(In, Read, &Edit.Type);
+        Take(In, Read, &Edit.Place);
+    }
+    return true;
+}
+
+void CameraPath::Clear()
+{
+    Ticks.clear();
+    Edits.clear();
+    TickRate = REPLAY_TICK_RATE;
+}
+
+void CameraPath::RecordTick(const glm::vec3& Position, f32 Yaw, f32 Pitch, f32 FOV)
+{
+    u32 FirstEdit = Ticks.empty() ? 0 : Ticks.back().FirstEdit + Ticks.back().EditCount;
+    Ticks.push_back({Position, Yaw, Pitch, FOV, FirstEdit, (u16)(Edits.size() - FirstEdit)});
+}
+
+void CameraPath::RecordEdit(glm::ivec3 Block, u8 Type, bool Place)
+{
+    Edits.push_back({Block, Type, (u8)Place});
+}
+
+bool BuildReferencePath(const char* Name, CameraPath* Path)
+{
+    Path->Clear();
+
+    // Sprint Speed is About 50 Blocks a Second, Looking Slightly Down the Way it Runs
+    if (strcmp(Name, "sprint") == 0)
+    {
+        const f32 Distance = 64.0f * 16.0f;
+        const f32 Step = 50.0f / REPLAY_TICK_RATE;
+        for (f32 x = 0.0f; x <= Distance; x += Step)
+        {
+            Path->RecordTick(glm::vec3(x, 90.0f, 8.0f), 0.0f, -10.0f, 80.0f);
+        }
+        return true;
+    }
+
+    // Wall Straddles the x = 0 Chunk Border & the y = 80 Section Border, so Most Edits Remesh Two Sections or Chunks
+    // One Edit Every Other Tick, Placing Row by Row Then Breaking in the Same Order
+    if (strcmp(Name, "build") == 0)
+    {
+        const glm::vec3 Eye(0.0f, 88.0f, -24.0f);
+        for (u8 Pass = 0; Pass < 2; ++Pass)
+        {
+            for (s32 y = 72; y < 88; ++y)
+            {
+                for (s32 x = -8; x < 8; ++x)
+                {
+                    Path->RecordEdit(glm::ivec3(x, y, 0), BlockType::STONE, Pass == 0);
+                    Path->RecordTick(Eye, 90.0f, -5.0f, 60.0f);
+                    Path->RecordTick(Eye, 90.0f, -5.0f, 60.0f);
+                }
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
+
+static f64 Percentile(const std::vector<f64>& Sorted, f64 Fraction)
+{
+    if (Sorted.empty()) return 0.0;
+    size_t Index = std::min(Sorted.size() - 1, (size_t)(Fraction * (Sorted.size() - 1) + 0.5));
+    return Sorted[Index];
+}
+
+f64 PrintReplayReport(const char* Name, const ReplayResults& Results)
+{
+    std::vector<f64> Frames = Results.FrameMs;
+    std::sort(Frames.begin(), Frames.end());
+
+    std::vector<f64> Visible(Results.VisibleMs.begin(), Results.VisibleMs.end());
+    std::sort(Visible.begin(), Visible.end());
+
+    f64 Total = 0.0;
+    u32 Hitches = 0;
+    for (f64 Ms : Frames)
+    {
+        Total += Ms;
+        if (Ms > REPLAY_HITCH_MS) Hitches++;
+    }
+
+    printf("[replay] %s, %zu frames in %.2f s\n", Name, Frames.size(), Total / 1000.0);
+    printf("  frame                  mean %9.2f  p50 %9.2f  p90 %9.2f  p99 %9.2f  max %9.2f ms\n",
+        Frames.empty() ? 0.0 : Total / Frames.size(), Percentile(Frames, 0.5), Percentile(Frames, 0.9), Percentile(Frames, 0.99), Frames.empty() ? 0.0 : Frames.back());
+    printf("  hitches (> %.1f ms)    %9u\n", REPLAY_HITCH_MS, Hitches);
+    printf("  chunk visible          p50 %9.2f  p90 %9.2f  p99 %9.2f  max %9.2f ms (%zu chunks)\n",
+        Percentile(Visible, 0.5), Percentile(Visible, 0.9), Percentile(Visible, 0.99), Visible.empty() ? 0.0 : Visible.back(), Visible.size());
+    printf("  edit waits             %9u frames, %u edits missed\n", Results.WaitFrames, Results.MissedEdits);
+
+    return Percentile(Frames, 0.99);
+}
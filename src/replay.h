@@ -0,0 +1,64 @@
+#ifndef __REPLAY_H__
+#define __REPLAY_H__
+
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "utils/common.h"
+
+#define REPLAY_MAGIC 0x52564D54u // "TMVR" Read Little Endian
+#define REPLAY_VERSION 1
+#define REPLAY_TICK_RATE 60 // Replays Step the World at a Fixed 1 / REPLAY_TICK_RATE dt
+#define REPLAY_HITCH_MS 33.3 // Frames Slower Than Two Ticks Count as Hitches
+#define REPLAY_EDIT_WAIT_FRAMES 600 // Frames a Tick's Edits Wait for Their Chunk Before Being Counted Missed
+#define REPLAY_WORLD_DIRECTORY "replay_world" // Wiped Before Every Replay so Saved Edits Never Carry Into the Next Run
+
+// World Block Coordinates, Place of 0 Breaks the Block
+typedef struct
+{
+    glm::ivec3 Block;
+    u8 Type;
+    u8 Place;
+} PathEdit;
+
+// Camera After the Tick's Input, Edits Made During the Tick are Edits[FirstEdit, FirstEdit + EditCount)
+typedef struct
+{
+    glm::vec3 Position;
+    f32 Yaw, Pitch, FOV;
+    u32 FirstEdit;
+    u16 EditCount;
+} PathTick;
+
+// Header (Magic, Version, Tick Rate, Tick Count, Edit Count), Then 26 Bytes per Tick
+// (Position, Yaw, Pitch, FOV, Edit Count) Followed by 14 Bytes per Edit (Block, Type, Place)
+struct CameraPath
+{
+    bool Save(const char* Path) const;
+    bool Load(const char* Path);
+    void Clear();
+
+    void RecordTick(const glm::vec3& Position, f32 Yaw, f32 Pitch, f32 FOV);
+    void RecordEdit(glm::ivec3 Block, u8 Type, bool Place); // Belongs to the Tick Recorded Next
+
+    std::vector<PathTick> Ticks;
+    std::vector<PathEdit> Edits;
+    u32 TickRate = REPLAY_TICK_RATE;
+};
+
+// Paths Built in Code so Every Checkout Replays the Same Thing:
+// "sprint" Runs 64 Chunks Along +X, "build" Places Then Breaks a 16x16 Wall Across a Chunk Border
+bool BuildReferencePath(const char* Name, CameraPath* Path);
+
+typedef struct
+{
+    std::vector<f64> FrameMs;
+    std::vector<f32> VisibleMs; // Chunk Request to its First Uploaded Mesh
+    u32 WaitFrames; // Frames Spent Holding a Tick Until the Chunks Its Edits Touch Were Generated
+    u32 MissedEdits;
+} ReplayResults;
+
+// Prints Frame Time & Latency Percentiles, Returns the Frame Time p99 in Milliseconds
+f64 PrintReplayReport(const char* Name, const ReplayResults& Results);
+
+#endif
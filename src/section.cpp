@@ -0,0 +1,231 @@
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+
+#include "section.h"
+
+// Index Buffers Given Up by Sections That Went Uniform, Changed Width or Belonged to a Released Chunk
+// Shared by Every Thread That Packs Sections, Indexed by Width: 1, 2, 4 & 8 Bits
+static std::mutex SpareMutex;
+static std::vector<std::vector<u64>> SpareData[4];
+
+static u8 WidthClass(const size_t Words)
+{
+    switch (Words)
+    {
+        case SECTION_VOLUME * 1 / 64: return 0;
+        case SECTION_VOLUME * 2 / 64: return 1;
+        case SECTION_VOLUME * 4 / 64: return 2;
+        case SECTION_VOLUME * 8 / 64: return 3;
+    }
+    return 4;
+}
+
+static void ReleaseBuffer(std::vector<u64>& Buffer)
+{
+    u8 Class = WidthClass(Buffer.capacity());
+    if (Class < 4)
+    {
+        std::lock_guard<std::mutex> Lock(SpareMutex);
+        std::vector<std::vector<u64>>& Spares = SpareData[Class];
+        if (!Spares.capacity()) Spares.reserve(SECTION_SPARE_BUFFERS);
+        if (Spares.size() < SECTION_SPARE_BUFFERS)
+        {
+            Spares.push_back(std::move(Buffer));
+            Buffer = std::vector<u64>();
+            return;
+        }
+    }
+    std::vector<u64>().swap(Buffer);
+}
+
+// Smallest Supported Width That Can Address Count Palette Entries
+static u8 PaletteBits(const size_t Count)
+{
+    if (Count <= 1) return 0;
+    if (Count <= 2) return 1;
+    if (Count <= 4) return 2;
+    if (Count <= 16) return 4;
+    return 8;
+}
+
+static void WriteIndex(BlockSection* Section, const u16 Index, const u32 PaletteIndex)
+{
+    u32 Bit = (u32)Index * Section->Bits;
+    u64 Mask = (u64)((1u << Section->Bits) - 1) << (Bit & 63);
+    u64& Word = Section->Data[Bit >> 6];
+    Word = (Word & ~Mask) | ((u64)PaletteIndex << (Bit & 63));
+}
+
+void PackSection(BlockSection* Section, const u8 Blocks[SECTION_VOLUME])
+{
+    // Palette Order Follows First Appearance, Lookup Maps BlockType Back to its Index
+    u8 Lookup[256];
+    bool Seen[256] = {};
+    u8 Palette[256];
+    u16 PaletteSize = 0;
+    for (u16 i = 0; i < SECTION_VOLUME; ++i)
+    {
+        if (!Seen[Blocks[i]])
+        {
+            Seen[Blocks[i]] = true;
+            Lookup[Blocks[i]] = (u8)PaletteSize;
+            Palette[PaletteSize++] = Blocks[i];
+        }
+    }
+
+    // Palette Capacity is Kept so a Recycled Chunk Repacks Without Allocating, Index Buffers Go Back to the Spares
+    Section->Bits = PaletteBits(PaletteSize);
+    Section->Palette.reserve(std::max<size_t>(16, (size_t)1 << Section->Bits));
+    Section->Palette.assign(Palette, Palette + PaletteSize);
+    if (!Section->Bits)
+    {
+        Section->Value = Blocks[0];
+        Section->Palette.clear();
+        ReleaseSectionData(Section);
+        return;
+    }
+
+    // Whole Words at a Time, Each Holds 64 / Bits Consecutive Indices
+    const u8 Bits = Section->Bits;
+    const u32 PerWord = 64 / Bits;
+    SizeSectionData(Section, Bits);
+
+    const u8* Block = Blocks;
+    for (u64& Word : Section->Data)
+    {
+        u64 Packed = 0;
+        for (u32 i = 0; i < PerWord; ++i)
+        {
+            Packed |= (u64)Lookup[Block[i]] << (i * Bits);
+        }
+        Word = Packed;
+        Block += PerWord;
+    }
+}
+
+void UnpackSection(const BlockSection* Section, u8 Blocks[SECTION_VOLUME])
+{
+    if (!Section->Bits)
+    {
+        memset(Blocks, Section->Value, SECTION_VOLUME);
+        return;
+    }
+
+    // Whole Words at a Time, Each Holds 64 / Bits Consecutive Indices
+    const u8 Bits = Section->Bits;
+    const u32 PerWord = 64 / Bits;
+    const u64 Mask = (1u << Bits) - 1;
+    const u8* Palette = Section->Palette.data();
+
+    u16 Index = 0;
+    for (u64 Word : Section->Data)
+    {
+        for (u32 i = 0; i < PerWord; ++i)
+        {
+            Blocks[Index++] = Palette[Word & Mask];
+            Word >>= Bits;
+        }
+    }
+}
+
+void SetSectionBlock(BlockSection* Section, const u16 Index, const u8 Type)
+{
+    if (!Section->Bits && Section->Value == Type) return;
+
+    if (!Section->Bits)
+    {
+        // Uniform Section Splits Into a Two Entry Palette, Every Block Starts as the Old Value
+        Section->Palette.assign(1, Section->Value);
+        Section->Bits = 1;
+        SizeSectionData(Section, 1);
+        std::fill(Section->Data.begin(), Section->Data.end(), 0);
+    }
+
+    u32 PaletteIndex = 0;
+    while (PaletteIndex < Section->Palette.size() && Section->Palette[PaletteIndex] != Type)
+    {
+        PaletteIndex++;
+    }
+
+    // Palette Only Grows on Edits, Stale Entries are Dropped the Next Time the Section is Packed
+    if (PaletteIndex == Section->Palette.size())
+    {
+        if (PaletteIndex == (1u << Section->Bits))
+        {
+            ResizeSection(Section, PaletteBits(PaletteIndex + 1));
+        }
+        Section->Palette.push_back(Type);
+    }
+
+    WriteIndex(Section, Index, PaletteIndex);
+}
+
+// Re-Encodes Every Index at a New Width, Palette is Unchanged
+void ResizeSection(BlockSection* Section, const u8 Bits)
+{
+    std::vector<u64> Old;
+    Old.swap(Section->Data);
+    const u8 OldBits = Section->Bits;
+
+    Section->Bits = Bits;
+    SizeSectionData(Section, Bits);
+    std::fill(Section->Data.begin(), Section->Data.end(), 0);
+    for (u16 i = 0; i < SECTION_VOLUME; ++i)
+    {
+        u32 Bit = (u32)i * OldBits;
+        WriteIndex(Section, i, (u32)(Old[Bit >> 6] >> (Bit & 63)) & ((1u << OldBits) - 1));
+    }
+    ReleaseBuffer(Old);
+}
+
+size_t SectionBytes(const BlockSection* Section)
+{
+    return sizeof(BlockSection) + Section->Palette.capacity() + Section->Data.capacity() * sizeof(u64);
+}
+
+// Gives Data Room for Bits Wide Indices, Taking a Spare Buffer of Exactly That Width Before Allocating
+// When That Width Has Run Out the Narrowest Wider Spare is Borrowed, Releasing Sorts it Back by Capacity,
+// so Streaming Terrain That Shifts the Mix of Widths Doesn't Allocate While Other Widths Sit Unused
+// Contents are Left Undefined, Callers Overwrite Every Word
+void SizeSectionData(BlockSection* Section, const u8 Bits)
+{
+    const size_t Words = SECTION_VOLUME * Bits / 64;
+    if (Section->Data.capacity() == Words)
+    {
+        Section->Data.resize(Words);
+        return;
+    }
+
+    ReleaseBuffer(Section->Data);
+    {
+        std::lock_guard<std::mutex> Lock(SpareMutex);
+        for (u8 Class = WidthClass(Words); Class < 4; ++Class)
+        {
+            std::vector<std::vector<u64>>& Spares = SpareData[Class];
+            if (Spares.empty()) continue;
+
+            Section->Data.swap(Spares.back());
+            Spares.pop_back();
+            break;
+        }
+    }
+    Section->Data.resize(Words);
+}
+
+void ReleaseSectionData(BlockSection* Section)
+{
+    ReleaseBuffer(Section->Data);
+}
+
+// Every Spare in a Class Has That Class's Exact Width
+size_t SpareSectionBytes()
+{
+    std::lock_guard<std::mutex> Lock(SpareMutex);
+    size_t Bytes = 0;
+    for (u8 Class = 0; Class < 4; ++Class)
+    {
+        Bytes += SpareData[Class].size() * (SECTION_VOLUME * (1 << Class) / 64) * sizeof(u64);
+    }
+    return Bytes;
+}
@@ -0,0 +1,47 @@
+#ifndef __SECTION_H__
+#define __SECTION_H__
+
+#include <cstddef>
+#include <vector>
+
+#include "utils/common.h"
+
+#define SECTION_SIZE 16 // Matches CHUNK_SIZE, Sections are Cubes
+#define SECTION_VOLUME (SECTION_SIZE * SECTION_SIZE * SECTION_SIZE)
+#define SECTION_SPARE_BUFFERS 1024 // Spare Index Buffers Kept per Width, Any Beyond This are Freed
+
+// 16 High Slice of a Chunk's Blocks, Stored as Bit-Packed Indices Into a Local Palette
+// Bits of 0 Means Every Block is Value and Nothing Else is Allocated
+typedef struct
+{
+    u8 Bits; // 0, 1, 2, 4 or 8, Powers of Two so No Index Straddles Two Words
+    u8 Value;
+    std::vector<u8> Palette; // Palette Index -> BlockType
+    std::vector<u64> Data;
+} BlockSection;
+
+void PackSection(BlockSection* Section, const u8 Blocks[SECTION_VOLUME]);
+void UnpackSection(const BlockSection* Section, u8 Blocks[SECTION_VOLUME]);
+void SetSectionBlock(BlockSection* Section, const u16 Index, const u8 Type);
+void ResizeSection(BlockSection* Section, const u8 Bits);
+size_t SectionBytes(const BlockSection* Section);
+void SizeSectionData(BlockSection* Section, const u8 Bits);
+void ReleaseSectionData(BlockSection* Section);
+size_t SpareSectionBytes();
+
+// Local Block Position Inside a Section, Same Axis Order as GetBlockIndex
+inline u16 GetSectionIndex(const u8 x, const u8 y, const u8 z)
+{
+    return x + (y * SECTION_SIZE) + (z * SECTION_SIZE * SECTION_SIZE);
+}
+
+inline u8 GetSectionBlock(const BlockSection* Section, const u16 Index)
+{
+    if (!Section->Bits) return Section->Value;
+
+    u32 Bit = (u32)Index * Section->Bits;
+    u32 PaletteIndex = (u32)(Section->Data[Bit >> 6] >> (Bit & 63)) & ((1u << Section->Bits) - 1);
+    return Section->Palette[PaletteIndex];
+}
+
+#endif
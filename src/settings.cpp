@@ -0,0 +1,67 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include "settings.h"
+
+bool LoadSettings(const char* Path, Settings* Out)
+{
+    FILE* File = fopen(Path, "r");
+    if (!File) return false;
+
+    char Line[256];
+    u32 LineNumber = 0;
+    while (fgets(Line, sizeof(Line), File))
+    {
+        LineNumber++;
+
+        char* Comment = strchr(Line, '#');
+        if (Comment) *Comment = '\0';
+
+        char Key[64];
+        f64 Value;
+        char Extra;
+        s32 Fields = sscanf(Line, " %63[a-z_] = %lf %c", Key, &Value, &Extra);
+        if (Fields == EOF) continue; // Blank or Comment Only
+        if (Fields != 2)
+        {
+            fprintf(stderr, "%s:%u: Expected key = number\n", Path, LineNumber);
+            continue;
+        }
+
+        if (strcmp(Key, "render_distance") == 0)       Out->RenderDistance = (s32)Value;
+        else if (strcmp(Key, "upload_budget_us") == 0) Out->UploadBudgetUs = (u32)std::max(Value, 0.0);
+        else if (strcmp(Key, "worker_count") == 0)     Out->WorkerCount = (u32)std::max(Value, 0.0);
+        else if (strcmp(Key, "governor") == 0)         Out->Governor = Value != 0.0;
+        else if (strcmp(Key, "target_frame_ms") == 0)  Out->TargetFrameMs = (f32)Value;
+        else if (strcmp(Key, "memory_cap_mb") == 0)    Out->MemoryCapMB = (u32)std::max(Value, 0.0);
+        else fprintf(stderr, "%s:%u: Unknown setting '%s'\n", Path, LineNumber, Key);
+    }
+    fclose(File);
+
+    ClampSettings(Out);
+    return true;
+}
+
+bool SaveSettings(const char* Path, const Settings& In)
+{
+    FILE* File = fopen(Path, "w");
+    if (!File) return false;
+
+    fprintf(File, "render_distance = %d\n", In.RenderDistance);
+    fprintf(File, "upload_budget_us = %u\n", In.UploadBudgetUs);
+    fprintf(File, "worker_count = %u # 0 Picks One per Core, Less the Main Thread\n", In.WorkerCount);
+    fprintf(File, "governor = %d\n", In.Governor ? 1 : 0);
+    fprintf(File, "target_frame_ms = %.2f\n", In.TargetFrameMs);
+    fprintf(File, "memory_cap_mb = %u\n", In.MemoryCapMB);
+    return fclose(File) == 0;
+}
+
+void ClampSettings(Settings* In)
+{
+    In->RenderDistance = std::clamp(In->RenderDistance, MIN_RENDER_DISTANCE, MAX_RENDER_DISTANCE);
+    In->UploadBudgetUs = std::max(In->UploadBudgetUs, (u32)MIN_UPLOAD_BUDGET_US);
+    In->WorkerCount = std::min(In->WorkerCount, (u32)MAX_WORKER_COUNT);
+    In->TargetFrameMs = std::max(In->TargetFrameMs, 1.0f);
+    In->MemoryCapMB = std::max(In->MemoryCapMB, 64u);
+}
@@ -0,0 +1,39 @@
+#ifndef __SETTINGS_H__
+#define __SETTINGS_H__
+
+#include "utils/common.h"
+
+#define SETTINGS_FILE "settings.cfg" // Read From the Working Directory at Startup & by F5, Missing Means Defaults
+
+// Defaults for Settings Missing From the File
+#define RENDER_DISTANCE 64
+#define UPLOAD_BUDGET_US 2000 // Time Spent Uploading Finished Meshes Each Frame
+#define GOVERNOR_TARGET_MS 14.0f // Below a 60 Hz Frame so Vsync Waits Don't Count as Work
+#define GOVERNOR_MEMORY_MB 1024
+
+#define MIN_RENDER_DISTANCE 2
+#define MAX_RENDER_DISTANCE 96 // Loaded Square Plus MAX_RETAINED_CHUNKS Stays Inside MAX_CHUNK_SLOTS
+#define MIN_UPLOAD_BUDGET_US 250
+#define MAX_WORKER_COUNT 64
+
+// One "key = value" per Line, # Starts a Comment. Keys are the Field Names in snake_case:
+// render_distance, upload_budget_us, worker_count, governor, target_frame_ms, memory_cap_mb
+typedef struct
+{
+    s32 RenderDistance; // Chunks Streamed Around the Player, the Governor Only Ever Shrinks Below This
+    u32 UploadBudgetUs; // Per Frame Mesh Upload Time, Also Only Lowered by the Governor
+    u32 WorkerCount; // 0 Picks WorkerPool::DefaultWorkerCount
+    bool Governor; // Trade Radius & Upload Budget for Frame Time & Memory While Running
+    f32 TargetFrameMs; // Busy Time per Frame the Governor Holds, Slower of the CPU Frame & GPU World Pass
+    u32 MemoryCapMB; // Block Storage, Retained Chunks, Pooled Spares & the Whole Mesh Buffer Together
+} Settings;
+
+inline Settings Config = {RENDER_DISTANCE, UPLOAD_BUDGET_US, 0, false, GOVERNOR_TARGET_MS, GOVERNOR_MEMORY_MB}; // Global Settings
+
+// Keys Missing From the File Keep Their Current Values, Out of Range Values are Clamped
+// Returns False if the File Can't be Opened, Unknown Keys & Malformed Lines are Reported & Skipped
+bool LoadSettings(const char* Path, Settings* Out);
+bool SaveSettings(const char* Path, const Settings& In);
+void ClampSettings(Settings* In);
+
+#endif
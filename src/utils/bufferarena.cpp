@@ -0,0 +1,150 @@
+#include <algorithm>
+
+#include "bufferarena.h"
+
+// Buffers are Only Ever Bound to the Copy Targets so the Bound VAO's Element Buffer is Left Alone
+u32 BufferArena::CreateBuffer(u32 Elements)
+{
+    u32 Name;
+    glGenBuffers(1, &Name);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, Name);
+    glBufferData(GL_COPY_WRITE_BUFFER, (GLsizeiptr)Elements * ElementSize, nullptr, GL_DYNAMIC_DRAW);
+    return Name;
+}
+
+void BufferArena::Create(u32 Size, u32 InitialCapacity, u32 Max)
+{
+    ElementSize = Size;
+    Capacity = InitialCapacity;
+    MaxCapacity = Max;
+    Used = 0;
+    Buffer = CreateBuffer(Capacity);
+
+    FreeList.clear();
+    FreeList.push_back({0, Capacity});
+}
+
+void BufferArena::Destroy()
+{
+    glDeleteBuffers(1, &Buffer);
+    Buffer = 0;
+    Capacity = 0;
+    Used = 0;
+    FreeList.clear();
+}
+
+// First Fit, Returns False When No Single Free Range is Big Enough
+bool BufferArena::Allocate(u32 Count, ArenaRange* Range)
+{
+    if (!Count)
+    {
+        *Range = {0, 0};
+        return true;
+    }
+
+    for (size_t i = 0; i < FreeList.size(); ++i)
+    {
+        ArenaRange& Block = FreeList[i];
+        if (Block.Count < Count) continue;
+
+        *Range = {Block.Offset, Count};
+        Block.Offset += Count;
+        Block.Count -= Count;
+        if (!Block.Count)
+        {
+            FreeList.erase(FreeList.begin() + i);
+        }
+
+        Used += Count;
+        return true;
+    }
+    return false;
+}
+
+void BufferArena::Free(ArenaRange* Range)
+{
+    if (!Range->Count) return;
+
+    auto Next = std::lower_bound(FreeList.begin(), FreeList.end(), Range->Offset, [](const ArenaRange& Block, u32 Offset)
+    {
+        return Block.Offset < Offset;
+    });
+    auto Inserted = FreeList.insert(Next, *Range);
+    Used -= Range->Count;
+    *Range = {0, 0};
+
+    // Merge With the Following Then the Preceding Range so Free Space Never Splinters Needlessly
+    if (Inserted + 1 != FreeList.end() && Inserted->Offset + Inserted->Count == (Inserted + 1)->Offset)
+    {
+        Inserted->Count += (Inserted + 1)->Count;
+        FreeList.erase(Inserted + 1);
+    }
+    if (Inserted != FreeList.begin() && (Inserted - 1)->Offset + (Inserted - 1)->Count == Inserted->Offset)
+    {
+        (Inserted - 1)->Count += Inserted->Count;
+        FreeList.erase(Inserted);
+    }
+}
+
+void BufferArena::Upload(const ArenaRange& Range, const void* Data)
+{
+    glBindBuffer(GL_COPY_WRITE_BUFFER, Buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, (GLintptr)Range.Offset * ElementSize, (GLsizeiptr)Range.Count * ElementSize, Data);
+}
+
+// Packs Every Live Range to the Front of a Fresh Buffer, Copies Stay on the GPU
+void BufferArena::Compact(std::vector<ArenaRange*>& Live)
+{
+    std::sort(Live.begin(), Live.end(), [](const ArenaRange* a, const ArenaRange* b)
+    {
+        return a->Offset < b->Offset;
+    });
+
+    u32 Compacted = CreateBuffer(Capacity);
+    glBindBuffer(GL_COPY_READ_BUFFER, Buffer);
+
+    u32 Offset = 0;
+    for (ArenaRange* Range : Live)
+    {
+        if (!Range->Count) continue;
+
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, (GLintptr)Range->Offset * ElementSize, (GLintptr)Offset * ElementSize, (GLsizeiptr)Range->Count * ElementSize);
+        Range->Offset = Offset;
+        Offset += Range->Count;
+    }
+
+    glDeleteBuffers(1, &Buffer);
+    Buffer = Compacted;
+    Used = Offset;
+
+    FreeList.clear();
+    if (Offset < Capacity)
+    {
+        FreeList.push_back({Offset, Capacity - Offset});
+    }
+}
+
+// Doubles Capacity Until MinimumCount More Elements Fit at the End, Capped at MaxCapacity
+bool BufferArena::Grow(u32 MinimumCount)
+{
+    u32 Tail = (!FreeList.empty() && FreeList.back().Offset + FreeList.back().Count == Capacity) ? FreeList.back().Count : 0;
+
+    u32 NewCapacity = Capacity;
+    while (NewCapacity - Capacity + Tail < MinimumCount)
+    {
+        if (NewCapacity >= MaxCapacity) return false;
+        NewCapacity = std::min(NewCapacity * 2, MaxCapacity);
+    }
+
+    u32 Grown = CreateBuffer(NewCapacity);
+    glBindBuffer(GL_COPY_READ_BUFFER, Buffer);
+    glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, 0, 0, (GLsizeiptr)Capacity * ElementSize);
+    glDeleteBuffers(1, &Buffer);
+    Buffer = Grown;
+
+    ArenaRange Added = {Capacity, NewCapacity - Capacity};
+    Capacity = NewCapacity;
+    Used += Added.Count; // Free Takes it Back Out
+    Free(&Added);
+    return true;
+}
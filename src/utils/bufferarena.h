@@ -0,0 +1,37 @@
+#pragma once
+
+#include <vector>
+
+#include "glad/glad.h"
+#include "common.h"
+
+typedef struct
+{
+    u32 Offset; // In Elements, Not Bytes
+    u32 Count;
+} ArenaRange;
+
+// One Large GL Buffer Handed Out in Element Ranges, Lets Every Chunk Share a Single VAO
+struct BufferArena
+{
+    void Create(u32 ElementSize, u32 Capacity, u32 MaxCapacity);
+    void Destroy();
+
+    bool Allocate(u32 Count, ArenaRange* Range);
+    void Free(ArenaRange* Range);
+    void Upload(const ArenaRange& Range, const void* Data);
+
+    // Both Replace Buffer, Anything Pointing at the Old Name (VAO Bindings) Must be Rebound
+    void Compact(std::vector<ArenaRange*>& Live);
+    bool Grow(u32 MinimumCount);
+
+    u32 Buffer = 0;
+    u32 ElementSize = 0;
+    u32 Capacity = 0;
+    u32 MaxCapacity = 0;
+    u32 Used = 0;
+    std::vector<ArenaRange> FreeList; // Sorted by Offset, Neighbors Coalesced on Free
+
+private:
+    u32 CreateBuffer(u32 Elements);
+};
@@ -15,6 +15,8 @@ Camera::Camera(glm::vec3 CameraPosition, glm::vec2 WindowSize)
 
 void Camera::Update(GLFWwindow* window, f32 dt) 
 {
+    PROFILE_ZONE("CameraUpdate");
+
     glfwGetCursorPos(window, &CurrentMousePosition.x, &CurrentMousePosition.y);
 
     glm::vec2 MousePositionDelta = CurrentMousePosition - PreviousMousePosition;
@@ -33,6 +35,13 @@ void Camera::Update(GLFWwindow* window, f32 dt)
         Pitch = -89.0f;
     }
 
+    Look(Yaw, Pitch);
+}
+
+void Camera::Look(f32 NewYaw, f32 NewPitch)
+{
+    Yaw = NewYaw;
+    Pitch = NewPitch;
     Direction = glm::normalize(glm::vec3(cos(glm::radians(Yaw)) * cos(glm::radians(Pitch)), sin(glm::radians(Pitch)), sin(glm::radians(Yaw)) * cos(glm::radians(Pitch))));
 }
 
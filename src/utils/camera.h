@@ -5,15 +5,27 @@
 #include "glm/glm.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "common.h"
+#include "profiler.h"
 
 #define NEAR_PLANE 0.1f
 #define FAR_PLANE 10000.0f
 
+#define CAMERA_UNIFORM_BINDING 0
+
+// std140 Layout of the Camera Block in vertex.glsl & debugvertex.glsl, Uploaded Once per Frame
+typedef struct
+{
+    glm::mat4 View;
+    glm::mat4 Projection;
+    glm::mat4 ViewProjection;
+} CameraUniforms;
+
 struct Camera
 {
     Camera(glm::vec3 CameraPosition, glm::vec2 WindowSize);
 
     void Update(GLFWwindow* window, f32 dt);
+    void Look(f32 NewYaw, f32 NewPitch); // Sets Orientation Directly, Used by Replays in Place of the Mouse
     glm::mat4 ViewMatrix();
     glm::mat4 ProjectionMatrix();
 
@@ -0,0 +1,199 @@
+#include <cstddef>
+
+#include "debugdraw.h"
+
+// 3x5 Glyphs for ' ' Through '_', Bit (Row * 3 + Column) Set Where the Pixel is Lit, Row 0 at the Top
+static const u16 DebugFont[64] =
+{
+    0x0000, 0x2092, 0x002D, 0x5F7D, 0x3C9E, 0x52A5, 0x6AAA, 0x0012,
+    0x4494, 0x1491, 0x0AA8, 0x05D0, 0x1400, 0x01C0, 0x2000, 0x12A4,
+    0x7B6F, 0x749A, 0x73E7, 0x79A7, 0x49ED, 0x79CF, 0x7BCF, 0x24A7,
+    0x7BEF, 0x79EF, 0x0410, 0x1410, 0x4454, 0x0E38, 0x1511, 0x21A7,
+    0x73EF, 0x5BEA, 0x3AEB, 0x624E, 0x3B6B, 0x72CF, 0x12CF, 0x6B4E,
+    0x5BED, 0x7497, 0x2B24, 0x5AED, 0x7249, 0x5BFD, 0x5B6B, 0x2B6A,
+    0x12EB, 0x676A, 0x5AEB, 0x388E, 0x2497, 0x7B6D, 0x2B6D, 0x5FED,
+    0x5AAD, 0x24AD, 0x72A7, 0x6496, 0x4889, 0x3493, 0x002A, 0x7000,
+};
+
+static inline DebugVertex MakeDebugVertex(const glm::vec3& Position, const glm::vec3& Color, const u8 Space)
+{
+    glm::vec3 Clamped = glm::clamp(Color, 0.0f, 1.0f) * 255.0f + 0.5f;
+    return {Position, {(u8)Clamped.r, (u8)Clamped.g, (u8)Clamped.b}, Space};
+}
+
+void DebugDraw::Create()
+{
+    Capacity = DEBUG_DRAW_CAPACITY;
+
+    glGenVertexArrays(1, &VAO);
+    glBindVertexArray(VAO);
+
+    glGenBuffers(1, &Buffer);
+    glBindBuffer(GL_ARRAY_BUFFER, Buffer);
+    glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)Capacity * sizeof(DebugVertex), nullptr, GL_STREAM_DRAW);
+
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(DebugVertex), (void*)offsetof(DebugVertex, Position));
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(DebugVertex), (void*)offsetof(DebugVertex, Color));
+    glEnableVertexAttribArray(1);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void DebugDraw::Destroy()
+{
+    glDeleteBuffers(1, &Buffer);
+    glDeleteVertexArrays(1, &VAO);
+    Buffer = 0;
+    VAO = 0;
+    Capacity = 0;
+    Clear();
+}
+
+// Primitives are Dropped Whole, Never Cut Off Partway
+bool DebugDraw::Reserve(u32 Count)
+{
+    if (Lines.size() + Triangles.size() + Count > DEBUG_DRAW_MAX_VERTICES)
+    {
+        Dropped += Count;
+        return false;
+    }
+    return true;
+}
+
+void DebugDraw::Line(const glm::vec3& a, const glm::vec3& b, const glm::vec3& Color)
+{
+    if (!Reserve(2)) return;
+
+    Lines.push_back(MakeDebugVertex(a, Color, 0));
+    Lines.push_back(MakeDebugVertex(b, Color, 0));
+}
+
+void DebugDraw::Box(const glm::vec3& Min, const glm::vec3& Max, const glm::vec3& Color)
+{
+    if (!Reserve(24)) return;
+
+    // Corner Bits Pick Max Over Min per Axis, x = 1, y = 2, z = 4
+    static const u8 Edges[24] =
+    {
+        0, 1, 2, 3, 4, 5, 6, 7, // Along X
+        0, 2, 1, 3, 4, 6, 5, 7, // Along Y
+        0, 4, 1, 5, 2, 6, 3, 7, // Along Z
+    };
+
+    DebugVertex Corners[8];
+    for (u8 i = 0; i < 8; ++i)
+    {
+        Corners[i] = MakeDebugVertex(glm::vec3(i & 1 ? Max.x : Min.x, i & 2 ? Max.y : Min.y, i & 4 ? Max.z : Min.z), Color, 0);
+    }
+    for (u8 Corner : Edges) Lines.push_back(Corners[Corner]);
+}
+
+void DebugDraw::ScreenLine(const glm::vec2& a, const glm::vec2& b, const glm::vec3& Color)
+{
+    if (!Reserve(2)) return;
+
+    Lines.push_back(MakeDebugVertex(glm::vec3(a, 0.0f), Color, 255));
+    Lines.push_back(MakeDebugVertex(glm::vec3(b, 0.0f), Color, 255));
+}
+
+void DebugDraw::Text(const glm::vec2& Position, const char* String, const glm::vec3& Color, const f32 Scale)
+{
+    glm::vec2 Cursor = Position;
+
+    for (const char* c = String; *c; ++c)
+    {
+        if (*c == '\n')
+        {
+            Cursor = glm::vec2(Position.x, Cursor.y - 6.0f * Scale);
+            continue;
+        }
+
+        u8 Character = (u8)*c;
+        if (Character >= 'a' && Character <= 'z') Character -= 'a' - 'A';
+        u16 Glyph = (Character >= ' ' && Character <= '_') ? DebugFont[Character - ' '] : DebugFont['?' - ' '];
+
+        // Lit Pixels in a Row are Merged Into One Quad
+        for (u8 Row = 0; Row < 5; ++Row)
+        {
+            u8 Bits = (Glyph >> (Row * 3)) & 7;
+            for (u8 Column = 0; Column < 3; ++Column)
+            {
+                if (!(Bits >> Column & 1)) continue;
+
+                u8 End = Column;
+                while (End + 1 < 3 && (Bits >> (End + 1) & 1)) End++;
+                if (!Reserve(6)) return;
+
+                f32 x0 = Cursor.x + Column * Scale, x1 = Cursor.x + (End + 1) * Scale;
+                f32 y1 = Cursor.y - Row * Scale, y0 = y1 - Scale;
+                DebugVertex Quad[4] =
+                {
+                    MakeDebugVertex(glm::vec3(x0, y0, 0.0f), Color, 255),
+                    MakeDebugVertex(glm::vec3(x1, y0, 0.0f), Color, 255),
+                    MakeDebugVertex(glm::vec3(x1, y1, 0.0f), Color, 255),
+                    MakeDebugVertex(glm::vec3(x0, y1, 0.0f), Color, 255),
+                };
+                const u8 Pattern[6] = {0, 1, 2, 0, 2, 3};
+                for (u8 i : Pattern) Triangles.push_back(Quad[i]);
+
+                Column = End;
+            }
+        }
+        Cursor.x += 4.0f * Scale;
+    }
+}
+
+// Orphans & Refills the Same Buffer Each Frame, it Only Gets Reallocated Bigger
+void DebugDraw::Flush(Shader& shader, const glm::mat4& ScreenProjection)
+{
+    PROFILE_ZONE("DebugDraw");
+
+    u32 LineCount = (u32)Lines.size();
+    u32 TriangleCount = (u32)Triangles.size();
+    LastVertices = LineCount + TriangleCount;
+    LastDropped = Dropped;
+
+    if (LastVertices)
+    {
+        while (Capacity < LastVertices) Capacity *= 2;
+
+        glBindBuffer(GL_ARRAY_BUFFER, Buffer);
+        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)Capacity * sizeof(DebugVertex), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_ARRAY_BUFFER, 0, (GLsizeiptr)LineCount * sizeof(DebugVertex), Lines.data());
+        glBufferSubData(GL_ARRAY_BUFFER, (GLintptr)LineCount * sizeof(DebugVertex), (GLsizeiptr)TriangleCount * sizeof(DebugVertex), Triangles.data());
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+
+        shader.Use();
+        shader.SetMat4("ScreenProjection", ScreenProjection);
+
+        glDisable(GL_DEPTH_TEST);
+        glDisable(GL_CULL_FACE);
+        glBindVertexArray(VAO);
+        if (LineCount)
+        {
+            glLineWidth(2.5f);
+            glDrawArrays(GL_LINES, 0, LineCount);
+            PROFILE_COUNT(DRAW_CALLS, 1);
+        }
+        if (TriangleCount)
+        {
+            glDrawArrays(GL_TRIANGLES, LineCount, TriangleCount);
+            PROFILE_COUNT(DRAW_CALLS, 1);
+        }
+        glBindVertexArray(0);
+        glEnable(GL_CULL_FACE);
+        glEnable(GL_DEPTH_TEST);
+    }
+
+    Clear();
+}
+
+// Vectors Keep Their Capacity so a Steady Frame Stops Allocating
+void DebugDraw::Clear()
+{
+    Lines.clear();
+    Triangles.clear();
+    Dropped = 0;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <vector>
+
+#include "glad/glad.h"
+#include "glm/glm.hpp"
+#include "common.h"
+#include "shader.h"
+#include "profiler.h"
+
+#define DEBUG_DRAW_CAPACITY (1 << 14) // Vertices the Stream Buffer Starts With, Doubled When a Frame Needs More
+#define DEBUG_DRAW_MAX_VERTICES (1 << 20) // Lines & Triangles Past This Many Vertices in a Frame are Dropped
+
+// Space is 0 for World Positions & 255 for Screen Pixels (Origin Bottom Left), Read as Color Alpha by debugvertex.glsl
+typedef struct
+{
+    glm::vec3 Position;
+    u8 Color[3];
+    u8 Space;
+} DebugVertex;
+
+// Lines, Boxes & Text Collected From Anywhere During a Frame, Drawn on Top of Everything by Flush
+// in One Call for Lines & One for Triangles From a Single Stream Buffer Created Once
+struct DebugDraw
+{
+    void Create();
+    void Destroy();
+
+    void Line(const glm::vec3& a, const glm::vec3& b, const glm::vec3& Color);
+    void Box(const glm::vec3& Min, const glm::vec3& Max, const glm::vec3& Color);
+    void ScreenLine(const glm::vec2& a, const glm::vec2& b, const glm::vec3& Color);
+
+    // Uppercase 3x5 Pixel Font, Position is the Top Left of the First Glyph, Newlines Start a New Row
+    void Text(const glm::vec2& Position, const char* String, const glm::vec3& Color, const f32 Scale = 2.0f);
+
+    void Flush(Shader& shader, const glm::mat4& ScreenProjection); // World Positions Use the Camera Uniform Block
+    void Clear();
+
+    std::vector<DebugVertex> Lines; // Pairs of Vertices
+    std::vector<DebugVertex> Triangles;
+    u32 Dropped = 0; // Vertices Turned Away This Frame for Going Past DEBUG_DRAW_MAX_VERTICES
+    u32 LastVertices = 0; // Vertices Drawn by the Last Flush
+    u32 LastDropped = 0; // Dropped Count From the Frame the Last Flush Drew
+
+    u32 VAO = 0;
+    u32 Buffer = 0;
+    u32 Capacity = 0;
+
+private:
+    bool Reserve(u32 Count);
+};
+
+inline DebugDraw Debug; // Global Debug Draw Batch
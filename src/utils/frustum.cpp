@@ -0,0 +1,92 @@
+#include "frustum.h"
+
+void BoxList::Clear()
+{
+    CenterX.clear();
+    CenterY.clear();
+    CenterZ.clear();
+    ExtentX.clear();
+    ExtentY.clear();
+    ExtentZ.clear();
+}
+
+void BoxList::Add(const glm::vec3& Min, const glm::vec3& Max)
+{
+    glm::vec3 Center = (Min + Max) * 0.5f;
+    glm::vec3 Extent = (Max - Min) * 0.5f;
+
+    CenterX.push_back(Center.x);
+    CenterY.push_back(Center.y);
+    CenterZ.push_back(Center.z);
+    ExtentX.push_back(Extent.x);
+    ExtentY.push_back(Extent.y);
+    ExtentZ.push_back(Extent.z);
+}
+
+size_t BoxList::Size() const
+{
+    return CenterX.size();
+}
+
+// Planes Come Straight From the Rows of the Combined Matrix (Gribb & Hartmann)
+void Frustum::Update(const glm::mat4& ViewProjection)
+{
+    glm::vec4 Row0(ViewProjection[0][0], ViewProjection[1][0], ViewProjection[2][0], ViewProjection[3][0]);
+    glm::vec4 Row1(ViewProjection[0][1], ViewProjection[1][1], ViewProjection[2][1], ViewProjection[3][1]);
+    glm::vec4 Row2(ViewProjection[0][2], ViewProjection[1][2], ViewProjection[2][2], ViewProjection[3][2]);
+    glm::vec4 Row3(ViewProjection[0][3], ViewProjection[1][3], ViewProjection[2][3], ViewProjection[3][3]);
+
+    Planes[0] = Row3 + Row0; // Left
+    Planes[1] = Row3 - Row0; // Right
+    Planes[2] = Row3 + Row1; // Bottom
+    Planes[3] = Row3 - Row1; // Top
+    Planes[4] = Row3 + Row2; // Near
+    Planes[5] = Row3 - Row2; // Far
+
+    for (glm::vec4& Plane : Planes)
+    {
+        Plane /= glm::length(glm::vec3(Plane));
+    }
+}
+
+void Frustum::Cull(const BoxList& Boxes, std::vector<u8>& Visible) const
+{
+    const size_t Count = Boxes.Size();
+    Visible.assign(Count, 1);
+
+    const f32* CenterX = Boxes.CenterX.data();
+    const f32* CenterY = Boxes.CenterY.data();
+    const f32* CenterZ = Boxes.CenterZ.data();
+    const f32* ExtentX = Boxes.ExtentX.data();
+    const f32* ExtentY = Boxes.ExtentY.data();
+    const f32* ExtentZ = Boxes.ExtentZ.data();
+    u8* Result = Visible.data();
+
+    // One Plane at a Time Over Every Box, the Inner Loop Has No Branches so the Compiler Vectorizes It
+    for (const glm::vec4& Plane : Planes)
+    {
+        const f32 nx = Plane.x, ny = Plane.y, nz = Plane.z, d = Plane.w;
+        const f32 ax = abs_(nx), ay = abs_(ny), az = abs_(nz);
+
+        for (size_t i = 0; i < Count; ++i)
+        {
+            f32 Distance = CenterX[i] * nx + CenterY[i] * ny + CenterZ[i] * nz + d;
+            f32 Radius = ExtentX[i] * ax + ExtentY[i] * ay + ExtentZ[i] * az;
+            Result[i] &= (u8)(Distance + Radius >= 0.0f);
+        }
+    }
+}
+
+bool Frustum::Touches(const glm::vec3& Min, const glm::vec3& Max) const
+{
+    const glm::vec3 Center = (Min + Max) * 0.5f;
+    const glm::vec3 Extent = (Max - Min) * 0.5f;
+
+    for (const glm::vec4& Plane : Planes)
+    {
+        f32 Distance = glm::dot(glm::vec3(Plane), Center) + Plane.w;
+        f32 Radius = glm::dot(Extent, glm::abs(glm::vec3(Plane)));
+        if (Distance + Radius < 0.0f) return false;
+    }
+    return true;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "common.h"
+
+// Axis Aligned Boxes Kept as Separate Component Arrays so the Plane Tests Vectorize
+struct BoxList
+{
+    void Clear();
+    void Add(const glm::vec3& Min, const glm::vec3& Max);
+    size_t Size() const;
+
+    std::vector<f32> CenterX, CenterY, CenterZ;
+    std::vector<f32> ExtentX, ExtentY, ExtentZ;
+};
+
+struct Frustum
+{
+    void Update(const glm::mat4& ViewProjection);
+
+    // Visible[i] is 1 When Box i Touches the Frustum, Conservative Near Corners & Edges
+    void Cull(const BoxList& Boxes, std::vector<u8>& Visible) const;
+    bool Touches(const glm::vec3& Min, const glm::vec3& Max) const; // Same Test for a Single Box
+
+    glm::vec4 Planes[6]; // Normal in xyz, Distance in w, Points With Dot >= 0 are Inside
+};
@@ -0,0 +1,226 @@
+#include <chrono>
+#include <cstdio>
+
+#include "profiler.h"
+
+static const char* CounterNames[PROFILE_COUNTER_COUNT] =
+{
+    "ChunksGenerated",
+    "ChunksLoaded",
+    "ChunksMeshed",
+    "MeshesUploaded",
+    "DrawCalls",
+    "Triangles",
+};
+
+// Gives the Ring Back When its Thread Exits, so Resizing the Worker Pool Doesn't Grow the Ring List
+struct LocalRingHandle
+{
+    ZoneRing* Ring = nullptr;
+
+    ~LocalRingHandle()
+    {
+        if (!Ring) return;
+        std::lock_guard<std::mutex> Lock(Profile.RingMutex);
+        Profile.FreeRings.push_back(Ring);
+    }
+};
+
+static thread_local LocalRingHandle LocalRing;
+
+u64 ProfileNow()
+{
+    static const std::chrono::steady_clock::time_point Epoch = std::chrono::steady_clock::now();
+    return (u64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Epoch).count();
+}
+
+// First Zone on a Thread Takes a Free Ring or Registers a New One, Every Later One Touches Only That Thread's Memory
+// A Recycled Ring Keeps its Thread Index & Older Zones, the New Thread Just Continues the Same Track
+static ZoneRing* GetLocalRing()
+{
+    if (LocalRing.Ring) return LocalRing.Ring;
+
+    std::lock_guard<std::mutex> Lock(Profile.RingMutex);
+    ZoneRing* Ring;
+    if (!Profile.FreeRings.empty())
+    {
+        Ring = Profile.FreeRings.back();
+        Profile.FreeRings.pop_back();
+    }
+    else
+    {
+        Ring = new ZoneRing();
+        Ring->Thread = (u32)Profile.Rings.size();
+        Ring->Head.store(0, std::memory_order_relaxed);
+        Profile.Rings.emplace_back(Ring);
+    }
+
+    LocalRing.Ring = Ring;
+    return Ring;
+}
+
+void RecordProfileZone(const char* Name, u64 Start, u64 End)
+{
+    ZoneRing* Ring = GetLocalRing();
+    u64 Head = Ring->Head.load(std::memory_order_relaxed);
+    Ring->Zones[Head & (PROFILER_THREAD_ZONES - 1)] = {Name, Start, End};
+    Ring->Head.store(Head + 1, std::memory_order_release);
+}
+
+// Closes the Frame's Record & Collects Any Timer Queries the GPU Has Finished Since
+void EndProfileFrame()
+{
+    Profile.MainThread = GetLocalRing()->Thread;
+
+    FrameRecord& Record = Profile.Frames[Profile.FrameCount % PROFILER_FRAMES];
+    Record.Frame = Profile.FrameCount;
+    Record.Start = Profile.FrameStart;
+    Record.End = ProfileNow();
+    Record.GpuWorldNs = -1;
+    for (u8 i = 0; i < PROFILE_COUNTER_COUNT; ++i)
+    {
+        Record.Counters[i] = Profile.Counters[i].exchange(0, std::memory_order_relaxed);
+    }
+
+    Profile.FrameStart = Record.End;
+    Profile.FrameCount++;
+
+    for (u32 i = 0; i < PROFILER_GPU_QUERIES; ++i)
+    {
+        if (!Profile.QueryPending[i]) continue;
+
+        GLint Available = 0;
+        glGetQueryObjectiv(Profile.Queries[i], GL_QUERY_RESULT_AVAILABLE, &Available);
+        if (!Available) continue;
+
+        GLuint64 Elapsed = 0;
+        glGetQueryObjectui64v(Profile.Queries[i], GL_QUERY_RESULT, &Elapsed);
+        Profile.QueryPending[i] = false;
+        Profile.LastGpuWorldNs = (s64)Elapsed;
+
+        // Frame Record May Already Have Been Overwritten if the Result Took Long Enough
+        FrameRecord& Timed = Profile.Frames[Profile.QueryFrames[i] % PROFILER_FRAMES];
+        if (Timed.Frame == Profile.QueryFrames[i]) Timed.GpuWorldNs = (s64)Elapsed;
+    }
+}
+
+// A Slot Whose Previous Query is Still Pending Skips the Frame Rather Than Stalling on It
+void BeginGpuTimer()
+{
+    if (!Profile.QueriesCreated)
+    {
+        glGenQueries(PROFILER_GPU_QUERIES, Profile.Queries);
+        Profile.QueriesCreated = true;
+    }
+
+    u32 Slot = (u32)(Profile.FrameCount % PROFILER_GPU_QUERIES);
+    if (Profile.QueryPending[Slot]) return;
+
+    glBeginQuery(GL_TIME_ELAPSED, Profile.Queries[Slot]);
+    Profile.QueryFrames[Slot] = Profile.FrameCount;
+    Profile.QueryActive = true;
+}
+
+void EndGpuTimer()
+{
+    if (!Profile.QueryActive) return;
+
+    glEndQuery(GL_TIME_ELAPSED);
+    Profile.QueryPending[Profile.FrameCount % PROFILER_GPU_QUERIES] = true;
+    Profile.QueryActive = false;
+}
+
+void ShutdownProfiler()
+{
+    if (Profile.QueriesCreated)
+    {
+        glDeleteQueries(PROFILER_GPU_QUERIES, Profile.Queries);
+        Profile.QueriesCreated = false;
+    }
+    for (u32 i = 0; i < PROFILER_GPU_QUERIES; ++i) Profile.QueryPending[i] = false;
+}
+
+// Rings Keep Being Written While This Runs, Zones Close to Being Overwritten are Left Out
+bool DumpProfileTrace(const char* Path)
+{
+    FILE* File = fopen(Path, "w");
+    if (!File) return false;
+
+    fprintf(File, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool First = true;
+    auto Separator = [&]()
+    {
+        if (!First) fprintf(File, ",\n");
+        First = false;
+    };
+
+    {
+        std::lock_guard<std::mutex> Lock(Profile.RingMutex);
+        for (const std::unique_ptr<ZoneRing>& Ring : Profile.Rings)
+        {
+            Separator();
+            if (Ring->Thread == Profile.MainThread)
+            {
+                fprintf(File, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"Main\"}}", Ring->Thread);
+            }
+            else
+            {
+                fprintf(File, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"Thread %u\"}}", Ring->Thread, Ring->Thread);
+            }
+
+            u64 Head = Ring->Head.load(std::memory_order_acquire);
+            u64 Oldest = Head > PROFILER_THREAD_ZONES ? Head - PROFILER_THREAD_ZONES + PROFILER_THREAD_ZONES / 16 : 0;
+            for (u64 i = Oldest; i < Head; ++i)
+            {
+                const ProfileZone& Zone = Ring->Zones[i & (PROFILER_THREAD_ZONES - 1)];
+                Separator();
+                fprintf(File, "{\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+                    Zone.Name, Ring->Thread, Zone.Start / 1000.0, (Zone.End - Zone.Start) / 1000.0);
+            }
+        }
+    }
+
+    u64 Oldest = Profile.FrameCount > PROFILER_FRAMES ? Profile.FrameCount - PROFILER_FRAMES : 0;
+    for (u64 Frame = Oldest; Frame < Profile.FrameCount; ++Frame)
+    {
+        const FrameRecord& Record = Profile.Frames[Frame % PROFILER_FRAMES];
+        Separator();
+        fprintf(File, "{\"name\":\"Counters\",\"ph\":\"C\",\"pid\":0,\"ts\":%.3f,\"args\":{", Record.Start / 1000.0);
+        for (u8 i = 0; i < PROFILE_COUNTER_COUNT; ++i)
+        {
+            fprintf(File, "%s\"%s\":%llu", i ? "," : "", CounterNames[i], (unsigned long long)Record.Counters[i]);
+        }
+        fprintf(File, "}}");
+
+        if (Record.GpuWorldNs >= 0)
+        {
+            Separator();
+            fprintf(File, "{\"name\":\"GPU World ms\",\"ph\":\"C\",\"pid\":0,\"ts\":%.3f,\"args\":{\"ms\":%.4f}}", Record.Start / 1000.0, Record.GpuWorldNs / 1e6);
+        }
+    }
+
+    fprintf(File, "\n]}\n");
+    return fclose(File) == 0;
+}
+
+bool DumpProfileCSV(const char* Path)
+{
+    FILE* File = fopen(Path, "w");
+    if (!File) return false;
+
+    fprintf(File, "Frame,CpuMs,GpuWorldMs");
+    for (u8 i = 0; i < PROFILE_COUNTER_COUNT; ++i) fprintf(File, ",%s", CounterNames[i]);
+    fprintf(File, "\n");
+
+    u64 Oldest = Profile.FrameCount > PROFILER_FRAMES ? Profile.FrameCount - PROFILER_FRAMES : 0;
+    for (u64 Frame = Oldest; Frame < Profile.FrameCount; ++Frame)
+    {
+        const FrameRecord& Record = Profile.Frames[Frame % PROFILER_FRAMES];
+        fprintf(File, "%llu,%.4f,", (unsigned long long)Record.Frame, (Record.End - Record.Start) / 1e6);
+        if (Record.GpuWorldNs >= 0) fprintf(File, "%.4f", Record.GpuWorldNs / 1e6);
+        for (u8 i = 0; i < PROFILE_COUNTER_COUNT; ++i) fprintf(File, ",%llu", (unsigned long long)Record.Counters[i]);
+        fprintf(File, "\n");
+    }
+
+    return fclose(File) == 0;
+}
\ No newline at end of file
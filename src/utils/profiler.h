@@ -0,0 +1,121 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "glad/glad.h"
+#include "common.h"
+
+// Build With PROFILER=0 to Compile Every PROFILE_ Macro Out
+#ifndef PROFILER
+#define PROFILER 1
+#endif
+
+#define PROFILER_THREAD_ZONES (1 << 14) // Zones Kept per Thread, the Oldest are Overwritten First
+#define PROFILER_FRAMES 1024 // Frame Records Kept
+#define PROFILER_GPU_QUERIES 4 // Frames a Timer Query Gets to Finish Before its Slot is Reused
+
+enum ProfileCounter
+{
+    CHUNKS_GENERATED = 0,
+    CHUNKS_LOADED = 1, // Read Back From Region Files Instead of Generated
+    CHUNKS_MESHED = 2,
+    MESHES_UPLOADED = 3,
+    DRAW_CALLS = 4,
+    TRIANGLES = 5,
+    PROFILE_COUNTER_COUNT = 6,
+};
+
+// Times are Nanoseconds Since the Profiler's Clock Started, Name Must Outlive the Profiler (a Literal)
+typedef struct
+{
+    const char* Name;
+    u64 Start;
+    u64 End;
+} ProfileZone;
+
+// Written Only by its Own Thread, Head Counts Every Zone Ever Recorded
+typedef struct
+{
+    u32 Thread;
+    std::atomic<u64> Head;
+    ProfileZone Zones[PROFILER_THREAD_ZONES];
+} ZoneRing;
+
+typedef struct
+{
+    u64 Frame;
+    u64 Start, End;
+    s64 GpuWorldNs; // -1 Until the Timer Query Comes Back, or When the Frame Wasn't Timed
+    u64 Counters[PROFILE_COUNTER_COUNT];
+} FrameRecord;
+
+typedef struct
+{
+    std::mutex RingMutex;
+    std::vector<std::unique_ptr<ZoneRing>> Rings; // One per Live Thread That Recorded a Zone, Plus the Free Ones
+    std::vector<ZoneRing*> FreeRings; // Left Behind by Exited Threads, Handed to the Next New One
+
+    std::atomic<u64> Counters[PROFILE_COUNTER_COUNT];
+
+    // Main Thread Only
+    FrameRecord Frames[PROFILER_FRAMES];
+    u64 FrameCount;
+    u64 FrameStart;
+
+    u32 Queries[PROFILER_GPU_QUERIES];
+    u64 QueryFrames[PROFILER_GPU_QUERIES];
+    bool QueryPending[PROFILER_GPU_QUERIES];
+    bool QueryActive;
+    bool QueriesCreated;
+    u32 MainThread; // Ring Thread Index of Whoever Calls EndProfileFrame
+    s64 LastGpuWorldNs; // Newest Result Read Back, 0 Before the First
+} ProfilerState;
+
+inline ProfilerState Profile; // Global Profiler
+
+u64 ProfileNow();
+void RecordProfileZone(const char* Name, u64 Start, u64 End);
+void EndProfileFrame();
+void ShutdownProfiler();
+
+// GL_TIME_ELAPSED Around One Pass per Frame, Results are Picked Up by a Later EndProfileFrame
+void BeginGpuTimer();
+void EndGpuTimer();
+
+// Chrome Trace (chrome://tracing, Perfetto) of Every Zone Still in the Rings Plus per Frame Counters
+bool DumpProfileTrace(const char* Path);
+bool DumpProfileCSV(const char* Path); // One Row per Frame Record
+
+inline void CountProfile(const u8 Counter, const u64 Amount)
+{
+    Profile.Counters[Counter].fetch_add(Amount, std::memory_order_relaxed);
+}
+
+struct ProfileScope
+{
+    ProfileScope(const char* ZoneName) : Name(ZoneName), Start(ProfileNow()) {}
+    ~ProfileScope() { RecordProfileZone(Name, Start, ProfileNow()); }
+
+    const char* Name;
+    u64 Start;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+#if PROFILER
+#define PROFILE_ZONE(Name) ProfileScope PROFILE_CONCAT(ProfileZone_, __LINE__)(Name)
+#define PROFILE_COUNT(Counter, Amount) CountProfile(ProfileCounter::Counter, (u64)(Amount))
+#define PROFILE_GPU_BEGIN() BeginGpuTimer()
+#define PROFILE_GPU_END() EndGpuTimer()
+#define PROFILE_FRAME_END() EndProfileFrame()
+#else
+#define PROFILE_ZONE(Name) ((void)0)
+#define PROFILE_COUNT(Counter, Amount) ((void)0)
+#define PROFILE_GPU_BEGIN() ((void)0)
+#define PROFILE_GPU_END() ((void)0)
+#define PROFILE_FRAME_END() ((void)0)
+#endif
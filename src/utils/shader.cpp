@@ -1,6 +1,6 @@
 #include "shader.h"
 
-Shader::Shader(const char* vertexPath, const char* fragmentPath)
+Shader::Shader(const char* vertexPath, const char* fragmentPath, const char* defines)
 {
 	std::ifstream vShaderFile;
 	std::ifstream fShaderFile;
@@ -19,6 +19,10 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath)
 	vertexCode = vShaderStream.str();
 	fragmentCode = fShaderStream.str();
 
+	// Defines Go Right After the #version Line
+	vertexCode.insert(vertexCode.find('\n') + 1, defines);
+	fragmentCode.insert(fragmentCode.find('\n') + 1, defines);
+
 	const char* vShaderCode = vertexCode.c_str();
 	const char* fShaderCode = fragmentCode.c_str();
 
@@ -37,6 +41,25 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath)
 
 	glDeleteShader(vertex);
 	glDeleteShader(fragment);
+
+	// Arrays Come Back as "Name[0]", Their Location is Also the Location of Plain "Name"
+	s32 Count = 0;
+	glGetProgramiv(ID, GL_ACTIVE_UNIFORMS, &Count);
+	for (s32 i = 0; i < Count; ++i)
+	{
+		char Name[128];
+		GLsizei Length;
+		GLint Size;
+		GLenum Type;
+		glGetActiveUniform(ID, (GLuint)i, sizeof(Name), &Length, &Size, &Type, Name);
+
+		s32 Location = glGetUniformLocation(ID, Name);
+		if (Location < 0) continue; // Members of Uniform Blocks Have No Location
+
+		std::string Trimmed(Name, Length);
+		if (Trimmed.size() > 3 && Trimmed.compare(Trimmed.size() - 3, 3, "[0]") == 0) Trimmed.resize(Trimmed.size() - 3);
+		Uniforms.push_back({Trimmed, Location});
+	}
 }
 
 void Shader::Use()
@@ -44,17 +67,33 @@ void Shader::Use()
 	glUseProgram(ID);
 }
 
+// Programs Have a Handful of Uniforms, a Scan Beats Hashing the Name
+s32 Shader::GetUniformLocation(const char* name) const
+{
+	for (const UniformLocation& Uniform : Uniforms)
+	{
+		if (Uniform.Name == name) return Uniform.Location;
+	}
+	return -1;
+}
+
+void Shader::BindUniformBlock(const char* name, u32 Binding) const
+{
+	u32 Index = glGetUniformBlockIndex(ID, name);
+	if (Index != GL_INVALID_INDEX) glUniformBlockBinding(ID, Index, Binding);
+}
+
 void Shader::SetMat4(const char* name, const glm::mat4& mat) const 
 {
-	glUniformMatrix4fv(glGetUniformLocation(ID, name), 1, GL_FALSE, &mat[0][0]);
+	glUniformMatrix4fv(GetUniformLocation(name), 1, GL_FALSE, &mat[0][0]);
 }
 
 void Shader::SetInt(const char* name, s32 value) const 
 {
-    glUniform1i(glGetUniformLocation(ID, name), value);
+    glUniform1i(GetUniformLocation(name), value);
 }
 
 void Shader::SetVec3(const char* name, const glm::vec3& vec) const
 {
-	glUniform3fv(glGetUniformLocation(ID, name), 1, &vec[0]);
+	glUniform3fv(GetUniformLocation(name), 1, &vec[0]);
 }
\ No newline at end of file
@@ -2,20 +2,35 @@
 
 #include <sstream>
 #include <fstream>
+#include <string>
+#include <vector>
 
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
 #include "glm/glm.hpp"
 #include "common.h"
 
+typedef struct
+{
+    std::string Name;
+    s32 Location;
+} UniformLocation;
+
 struct Shader 
 {
-    Shader(const char* vertex, const char* fragment);
+    Shader(const char* vertex, const char* fragment, const char* defines = "");
 
     void Use();
     void SetMat4(const char* name, const glm::mat4& mat) const;
     void SetVec3(const char* name, const glm::vec3& vec) const;
     void SetInt(const char* name, s32 value) const;
 
+    // -1 for Names the Linker Dropped or Never Saw, Which Every glUniform Call Ignores
+    s32 GetUniformLocation(const char* name) const;
+
+    // Points a Named Uniform Block at a Buffer Binding Index, Does Nothing if the Program Lacks the Block
+    void BindUniformBlock(const char* name, u32 Binding) const;
+
     u32 ID;
+    std::vector<UniformLocation> Uniforms; // Every Active Uniform, Resolved Once After Linking
 };
@@ -0,0 +1,27 @@
+#include "uniformbuffer.h"
+
+void UniformBuffer::Create(u32 BufferSize, u32 BindingIndex)
+{
+    Size = BufferSize;
+    Binding = BindingIndex;
+
+    glGenBuffers(1, &Buffer);
+    glBindBuffer(GL_UNIFORM_BUFFER, Buffer);
+    glBufferData(GL_UNIFORM_BUFFER, Size, nullptr, GL_DYNAMIC_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, Binding, Buffer);
+}
+
+void UniformBuffer::Destroy()
+{
+    glDeleteBuffers(1, &Buffer);
+    Buffer = 0;
+    Size = 0;
+}
+
+void UniformBuffer::Update(const void* Data)
+{
+    glBindBuffer(GL_UNIFORM_BUFFER, Buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, Size, Data);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
\ No newline at end of file
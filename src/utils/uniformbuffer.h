@@ -0,0 +1,18 @@
+#pragma once
+
+#include "glad/glad.h"
+#include "common.h"
+
+// Uniform Block Storage Shared by Every Program That Binds the Block to the Same Index
+struct UniformBuffer
+{
+    void Create(u32 BufferSize, u32 BindingIndex);
+    void Destroy();
+
+    // Replaces the Whole Block, Meant to be Called Once per Frame
+    void Update(const void* Data);
+
+    u32 Buffer = 0;
+    u32 Size = 0;
+    u32 Binding = 0;
+};
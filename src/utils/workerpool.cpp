@@ -0,0 +1,159 @@
+#include <algorithm>
+
+#include "workerpool.h"
+
+static inline s32 FocusDistance(glm::ivec3 Position, glm::ivec3 Focus)
+{
+    glm::ivec3 Delta = Position - Focus;
+    return Delta.x * Delta.x + Delta.z * Delta.z;
+}
+
+// Heap Comparator, the Job Nearest the Focus Ends Up at the Front
+static inline bool CloserJob(const Job& a, const Job& b)
+{
+    return a.Distance > b.Distance;
+}
+
+void WorkerPool::Start(u32 WorkerCount)
+{
+    Running = true;
+    for (u32 i = 0; i < WorkerCount; ++i)
+    {
+        Workers.emplace_back(&WorkerPool::WorkerLoop, this);
+    }
+}
+
+void WorkerPool::Stop()
+{
+    std::vector<Job> Dropped;
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        Running = false;
+        Dropped.swap(Jobs);
+    }
+    JobAvailable.notify_all();
+
+    for (Job& DroppedJob : Dropped)
+    {
+        if (DroppedJob.Discard) DroppedJob.Discard();
+    }
+
+    for (std::thread& Worker : Workers)
+    {
+        Worker.join();
+    }
+    Workers.clear();
+}
+
+// Every Worker Finishes its Current Job & Exits, Then the New Set Picks Up the Same Queue
+void WorkerPool::Resize(u32 WorkerCount)
+{
+    if (WorkerCount == Workers.size()) return;
+
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        Running = false;
+    }
+    JobAvailable.notify_all();
+
+    for (std::thread& Worker : Workers)
+    {
+        Worker.join();
+    }
+    Workers.clear();
+
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        Running = true;
+    }
+    for (u32 i = 0; i < WorkerCount; ++i)
+    {
+        Workers.emplace_back(&WorkerPool::WorkerLoop, this);
+    }
+}
+
+u64 WorkerPool::Submit(glm::ivec3 Position, std::function<void()> Execute, std::function<void()> Discard, u64 Id)
+{
+    if (!Id) Id = ReserveJobId();
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        Jobs.push_back({Id, Position, FocusDistance(Position, Focus), std::move(Execute), std::move(Discard)});
+        std::push_heap(Jobs.begin(), Jobs.end(), CloserJob);
+    }
+    JobAvailable.notify_one();
+    return Id;
+}
+
+u64 WorkerPool::ReserveJobId()
+{
+    return NextJobId.fetch_add(1, std::memory_order_relaxed);
+}
+
+// Drops the Job if it's Still Queued, Returns False if it Already Started, Finished or Was Never Submitted
+bool WorkerPool::Cancel(u64 Id)
+{
+    Cancelled.clear();
+    {
+        std::lock_guard<std::mutex> Lock(Mutex);
+        for (size_t i = 0; i < Jobs.size(); ++i)
+        {
+            if (Jobs[i].Id != Id) continue;
+
+            Cancelled.push_back(std::move(Jobs[i]));
+            Jobs[i] = std::move(Jobs.back());
+            Jobs.pop_back();
+            std::make_heap(Jobs.begin(), Jobs.end(), CloserJob);
+            break;
+        }
+    }
+
+    for (Job& CancelledJob : Cancelled)
+    {
+        if (CancelledJob.Discard) CancelledJob.Discard();
+    }
+    bool Found = !Cancelled.empty();
+    Cancelled.clear();
+    return Found;
+}
+
+void WorkerPool::SetFocus(glm::ivec3 Position)
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    if (Position == Focus) return;
+
+    Focus = Position;
+    for (Job& Queued : Jobs) Queued.Distance = FocusDistance(Queued.Position, Focus);
+    std::make_heap(Jobs.begin(), Jobs.end(), CloserJob);
+}
+
+size_t WorkerPool::QueuedJobs()
+{
+    std::lock_guard<std::mutex> Lock(Mutex);
+    return Jobs.size();
+}
+
+u32 WorkerPool::DefaultWorkerCount()
+{
+    // Leave One Core for the Main / GL Thread
+    u32 Cores = std::thread::hardware_concurrency();
+    return Cores > 1 ? Cores - 1 : 1;
+}
+
+void WorkerPool::WorkerLoop()
+{
+    while (true)
+    {
+        Job Next;
+        {
+            std::unique_lock<std::mutex> Lock(Mutex);
+            JobAvailable.wait(Lock, [this] { return !Running || !Jobs.empty(); });
+            if (!Running) return;
+
+            std::pop_heap(Jobs.begin(), Jobs.end(), CloserJob);
+            Next = std::move(Jobs.back());
+            Jobs.pop_back();
+        }
+
+        Next.Execute();
+    }
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "glm/glm.hpp"
+#include "common.h"
+
+typedef struct
+{
+    u64 Id; // Unique per Job, What Cancel Matches On
+    glm::ivec3 Position; // Chunk the Job Works On, Used for Priority
+    s32 Distance; // Squared xz Distance From the Focus, Kept Current by SetFocus
+    std::function<void()> Execute;
+    std::function<void()> Discard; // Optional, Runs Instead of Execute if the Job is Cancelled
+} Job;
+
+// Background Threads That Run Chunk Jobs Closest to the Focus Chunk First
+// Jobs are a Min Heap on Distance, Pops are O(log n) & Only a Focus Change Rebuilds it
+struct WorkerPool
+{
+    void Start(u32 WorkerCount);
+    void Stop();
+    void Resize(u32 WorkerCount); // Queued Jobs are Kept, Waits for Running Ones to Finish
+
+    // Returns the Job's Id, Pass One From ReserveJobId When Whoever Cancels Needs to Know it Before the Job is Submitted
+    u64 Submit(glm::ivec3 Position, std::function<void()> Execute, std::function<void()> Discard = nullptr, u64 Id = 0);
+    u64 ReserveJobId();
+    bool Cancel(u64 Id);
+    void SetFocus(glm::ivec3 Position);
+    size_t QueuedJobs();
+
+    static u32 DefaultWorkerCount();
+
+    std::mutex Mutex;
+    std::condition_variable JobAvailable;
+    std::vector<Job> Jobs; // Heap Ordered by CloserJob
+    std::vector<Job> Cancelled; // Reused by Cancel so it Never Allocates, Cancel is Only Called From One Thread
+    std::vector<std::thread> Workers;
+    std::atomic<u64> NextJobId{1}; // 0 is Never Handed Out
+    glm::ivec3 Focus = glm::ivec3(0);
+    bool Running = false;
+
+private:
+    void WorkerLoop();
+};